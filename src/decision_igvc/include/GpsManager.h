@@ -9,6 +9,7 @@
 #ifndef DECISION_GPSManager_H
 #define DECISION_GPSManager_H
 
+#include <DebugPublisher.h>
 #include <algorithm>
 #include <geometry_msgs/Point.h>
 #include <gps_common/conversions.h>
@@ -21,6 +22,7 @@
 #include <tf/transform_datatypes.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <vector>
+#include <visualization_msgs/Marker.h>
 
 // A struct to hold lat/lon coordinates (a waypoint)
 // lat/lon should be in degrees
@@ -74,7 +76,7 @@ class GpsManager {
 
     ros::Subscriber tf_subscriber;
     ros::Publisher current_waypoint_publisher;
-    ros::Publisher rviz_marker_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker> rviz_marker_publisher;
 
     std::string base_frame;   // The base frame of the robot ("base_link",
                               // "base_footprint", etc.)
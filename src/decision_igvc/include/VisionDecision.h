@@ -39,6 +39,15 @@ class VisionDecision {
   public:
     VisionDecision(int argc, char** argv, std::string node_name);
 
+    /**
+     * Constructor, for when ROS is already initialised, as in a nodelet
+     *
+     * @param nh the node handle to publish with
+     * @param private_nh the node handle to subscribe with and get parameters
+     * from
+     */
+    VisionDecision(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     /**
      * Determines the turning angle in relation to the orientation of
      * the white line in the image.
@@ -196,6 +205,11 @@ class VisionDecision {
     static int
     getLeftToRightPixelRatio(const sensor_msgs::Image::ConstPtr& image);
 
+    /**
+     * Sets up the subscriber and publisher, and gets the parameters
+     */
+    void setUpNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     void imageCallBack(const sensor_msgs::Image::ConstPtr& image);
 
     void publishTwist(geometry_msgs::Twist twist);
@@ -0,0 +1,39 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which produces a recommended twist message from
+ *              a filtered image of the lines.
+ *              Runs VisionDecision inside the vision pipeline's nodelet
+ *              manager, so filtered images arrive without being serialised.
+ */
+
+#ifndef DECISION_VISION_DECISION_NODELET_H
+#define DECISION_VISION_DECISION_NODELET_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+
+#include <VisionDecision.h>
+
+namespace decision_igvc {
+
+class VisionDecisionNodelet : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    VisionDecisionNodelet();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    // Does all the work, set up with the nodelet's node handles
+    boost::shared_ptr<VisionDecision> vision_decision;
+};
+}
+
+#endif // DECISION_VISION_DECISION_NODELET_H
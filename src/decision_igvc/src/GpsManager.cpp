@@ -27,10 +27,6 @@ GpsManager::GpsManager(int argc, char** argv, std::string node_name) {
     private_nh.resolveName("current_waypoint");
     current_waypoint_publisher = nh.advertise<geometry_msgs::PointStamped>(
     current_waypoint_topic, queue_size);
-    std::string marker_topic =
-    private_nh.resolveName("current_waypoint_marker");
-    rviz_marker_publisher =
-    nh.advertise<visualization_msgs::Marker>(marker_topic, queue_size);
 
     // Get Params
     SB_getParam(
@@ -39,6 +35,12 @@ GpsManager::GpsManager(int argc, char** argv, std::string node_name) {
     private_nh, "global_frame", global_frame, (std::string) "odom_combined");
     SB_getParam(
     private_nh, "at_goal_tolerance", at_goal_tolerance, (float) 1.0);
+    // The waypoint marker is only built when subscribed to, at most this often
+    double debug_rate;
+    SB_getParam(private_nh, "debug_rate", debug_rate, 10.0);
+    std::string marker_topic =
+    private_nh.resolveName("current_waypoint_marker");
+    rviz_marker_publisher.advertise(nh, marker_topic, debug_rate);
     std::vector<double>
     waypoints_raw; // The raw list of waypoints retrieved from the param server
     if (!SB_getParam(private_nh, "waypoints", waypoints_raw)) {
@@ -88,35 +90,40 @@ void GpsManager::tfCallBack(const tf2_msgs::TFMessageConstPtr tf_message) {
 void GpsManager::publishRvizWaypointMarker(
 geometry_msgs::PointStamped p,
 geometry_msgs::TransformStamped global_to_local_transform) {
-    // Inverse the transform
-    tf2::Transform t;
-    tf2::fromMsg(global_to_local_transform.transform, t);
-    t = t.inverse();
-
-    // Create a new geometry_msgs::Transform
-    geometry_msgs::TransformStamped t_stamped;
-    t_stamped.transform       = tf2::toMsg(t);
-    t_stamped.header          = global_to_local_transform.header;
-    t_stamped.header.frame_id = base_frame;
-
-    // Define a new point relative to base frame
-    geometry_msgs::PointStamped output;
-    tf2::doTransform(p, output, t_stamped);
-    output.point.z = 0; // Necessary to remove vertical transform of waypoint
-
-    // Create marker
-    std::vector<std_msgs::ColorRGBA> colors;
-    std_msgs::ColorRGBA color;
-    color.a = 1.0f;
-    color.r = 1.0f;
-    colors.push_back(color);
-    rviz_marker_publisher.publish(snowbots::RvizUtils::createMarker(
-    output.point,
-    colors,
-    snowbots::RvizUtils::createrMarkerScale(0.5, 0.5, 0.5),
-    base_frame,
-    "debug",
-    visualization_msgs::Marker::POINTS));
+    // Nothing is transformed or built unless someone is looking at the marker
+    rviz_marker_publisher.publish(
+    [ p, global_to_local_transform, base_frame = this->base_frame ] {
+        // Inverse the transform
+        tf2::Transform t;
+        tf2::fromMsg(global_to_local_transform.transform, t);
+        t = t.inverse();
+
+        // Create a new geometry_msgs::Transform
+        geometry_msgs::TransformStamped t_stamped;
+        t_stamped.transform       = tf2::toMsg(t);
+        t_stamped.header          = global_to_local_transform.header;
+        t_stamped.header.frame_id = base_frame;
+
+        // Define a new point relative to base frame
+        geometry_msgs::PointStamped output;
+        tf2::doTransform(p, output, t_stamped);
+        // Necessary to remove vertical transform of waypoint
+        output.point.z = 0;
+
+        // Create marker
+        std::vector<std_msgs::ColorRGBA> colors;
+        std_msgs::ColorRGBA color;
+        color.a = 1.0f;
+        color.r = 1.0f;
+        colors.push_back(color);
+        return snowbots::RvizUtils::createMarker(
+        output.point,
+        std::move(colors),
+        snowbots::RvizUtils::createrMarkerScale(0.5, 0.5, 0.5),
+        base_frame,
+        "debug",
+        visualization_msgs::Marker::POINTS);
+    });
 }
 
 std::vector<Waypoint>
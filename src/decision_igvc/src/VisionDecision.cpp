@@ -14,6 +14,16 @@ VisionDecision::VisionDecision(int argc, char** argv, std::string node_name) {
     ros::NodeHandle nh;
     ros::NodeHandle private_nh("~");
 
+    setUpNode(nh, private_nh);
+}
+
+VisionDecision::VisionDecision(ros::NodeHandle& nh,
+                               ros::NodeHandle& private_nh) {
+    setUpNode(nh, private_nh);
+}
+
+void VisionDecision::setUpNode(ros::NodeHandle& nh,
+                               ros::NodeHandle& private_nh) {
     // Setup Subscriber(s)
     std::string camera_image_topic_name = "/vision/filtered_image";
     uint32_t queue_size                 = 1;
@@ -0,0 +1,23 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which produces a recommended twist message from
+ *              a filtered image of the lines.
+ */
+
+#include <pluginlib/class_list_macros.h>
+#include <vision_decision_nodelet.h>
+
+using namespace decision_igvc;
+
+VisionDecisionNodelet::VisionDecisionNodelet() {}
+
+void VisionDecisionNodelet::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    vision_decision.reset(
+    new VisionDecision(getNodeHandle(), getPrivateNodeHandle()));
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(VisionDecisionNodelet, nodelet::Nodelet)
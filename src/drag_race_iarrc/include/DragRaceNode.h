@@ -11,6 +11,7 @@
 
 // STD Includes
 #include <iostream>
+#include <memory>
 #include <vector>
 
 // ROS Includes
@@ -22,6 +23,7 @@
 #include <std_msgs/String.h>
 
 // SB Includes
+#include <DebugPublisher.h>
 #include <DragRaceController.h>
 #include <LidarObstacleManager.h>
 #include <sb_utils.h>
@@ -86,12 +88,14 @@ class DragRaceNode {
     // Publishes Twist messages to control the robot
     ros::Publisher twist_publisher;
     // Publishes the obstacles so we can see them in RViz
-    ros::Publisher cone_debug_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker> cone_debug_publisher;
     // Publishes the cone lines so we can see them in RViz
-    ros::Publisher cone_line_debug_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker>
+    cone_line_debug_publisher;
     // Publishes the cone line we're using to determine the twist message
     // so we can see it in RViz
-    ros::Publisher best_line_debug_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker>
+    best_line_debug_publisher;
 };
 
 #endif // DRAG_RACE_NODE_DRAG_RACE_H
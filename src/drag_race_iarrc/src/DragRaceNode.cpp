@@ -32,19 +32,6 @@ DragRaceNode::DragRaceNode(int argc, char** argv, std::string node_name)
     std::string twist_topic = nh.resolveName("cmd_vel");
     twist_publisher =
     nh.advertise<geometry_msgs::Twist>(twist_topic, queue_size);
-    std::string cone_debug_topic = private_nh.resolveName("debug/cone");
-    cone_debug_publisher = private_nh.advertise<visualization_msgs::Marker>(
-    cone_debug_topic, queue_size);
-    std::string cone_lines_debug_topic =
-    private_nh.resolveName("debug/cone_lines");
-    cone_line_debug_publisher =
-    private_nh.advertise<visualization_msgs::Marker>(cone_lines_debug_topic,
-                                                     queue_size);
-    std::string best_line_debug_topic =
-    private_nh.resolveName("debug/best_line");
-    best_line_debug_publisher =
-    private_nh.advertise<visualization_msgs::Marker>(best_line_debug_topic,
-                                                     queue_size);
 
     // Get Params
     SB_getParam(private_nh, "target_distance", target_distance, 1.0);
@@ -88,6 +75,17 @@ DragRaceNode::DragRaceNode(int argc, char** argv, std::string node_name)
     SB_getParam(
     private_nh, "region_fill_percentage", region_fill_percentage, 0.5);
 
+    // Debug markers are only built when subscribed to, at most this often
+    double debug_rate;
+    SB_getParam(private_nh, "debug_rate", debug_rate, 10.0);
+
+    cone_debug_publisher.advertise(
+    private_nh, private_nh.resolveName("debug/cone"), debug_rate);
+    cone_line_debug_publisher.advertise(
+    private_nh, private_nh.resolveName("debug/cone_lines"), debug_rate);
+    best_line_debug_publisher.advertise(
+    private_nh, private_nh.resolveName("debug/best_line"), debug_rate);
+
     // Setup drag race controller with given params
     drag_race_controller = DragRaceController(target_distance,
                                               line_to_the_right,
@@ -173,11 +171,22 @@ void DragRaceNode::scanCallBack(const sensor_msgs::LaserScan::ConstPtr& scan) {
     // Publish our desired twist message
     twist_publisher.publish(twist);
 
-    // TODO: have a debug param for this
-    // Broadcast a visualisable representation so we can see obstacles in RViz
-    cone_debug_publisher.publish(obstacle_manager.getConeRVizMarker());
-    cone_line_debug_publisher.publish(
-    obstacle_manager.getConeLinesRVizMarker());
-    best_line_debug_publisher.publish(
-    obstacle_manager.getBestConeLineRVizMarker(line_to_the_right));
+    // Broadcast a visualisable representation so we can see obstacles in RViz.
+    // The markers are built off this thread from a snapshot of the obstacles,
+    // and only if someone is watching
+    if (cone_debug_publisher.isActive() ||
+        cone_line_debug_publisher.isActive() ||
+        best_line_debug_publisher.isActive()) {
+        std::shared_ptr<LidarObstacleManager> snapshot =
+        std::make_shared<LidarObstacleManager>(obstacle_manager);
+        bool line_to_the_right = this->line_to_the_right;
+
+        cone_debug_publisher.publish(
+        [snapshot] { return snapshot->getConeRVizMarker(); });
+        cone_line_debug_publisher.publish(
+        [snapshot] { return snapshot->getConeLinesRVizMarker(); });
+        best_line_debug_publisher.publish([snapshot, line_to_the_right] {
+            return snapshot->getBestConeLineRVizMarker(line_to_the_right);
+        });
+    }
 }
@@ -8,8 +8,10 @@
 #define LASERSCAN_CONE_MANAGER_H
 
 #include <ConeIdentification.h>
+#include <DebugPublisher.h>
 #include <RvizUtils.h>
 #include <iostream>
+#include <mapping_igvc/ConeObstacleArray.h>
 #include <ros/ros.h>
 #include <sb_utils.h>
 #include <sensor_msgs/LaserScan.h>
@@ -21,22 +23,23 @@ class ConeExtractorNode {
 
   private:
     ros::Subscriber laser_subscriber;
+    ros::Publisher cone_array_publisher;
     ros::Publisher cone_publisher;
-    ros::Publisher rviz_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker> rviz_publisher;
 
     /**
-     * Callback function for receiving laser scan msgs. Publishes the cones
-     * found in the laserscan to
-     * the correct topic one by one. Note that the coordinates for cones are in
-     * the base-link (robot frame)
+     * Callback function for receiving laser scan msgs. Publishes all the cones
+     * found in the laserscan in a single message, and also one by one if
+     * publish_individual_obstacles is set. Note that the coordinates for
+     * cones are in the base-link (robot frame)
      * @param ptr
      */
     void laserCallBack(const sensor_msgs::LaserScan::ConstPtr& ptr);
 
     /**
-     * Generate a visualization marker given a cone
-     * @param cone
-     * @return a visualization marker
+     * Publish a visualization marker of the given cones, if anyone is
+     * subscribed to it
+     * @param cones
      */
     void publishMarkers(std::vector<mapping_igvc::ConeObstacle> cones);
 
@@ -47,6 +50,7 @@ class ConeExtractorNode {
     int min_points_in_cone; // Index difference between points used in edge
                             // cluster splitting algorithm
     double ang_threshold;   // Max angle needed to split edge clusters
+    bool publish_individual_obstacles; // Also publish each cone on its own
 };
 
 #endif // LASERSCAN_CONE_MANAGER_H
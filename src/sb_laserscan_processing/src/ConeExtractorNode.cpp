@@ -42,18 +42,37 @@ ConeExtractorNode::ConeExtractorNode(int argc,
     SB_getParam(
     private_nh, ang_threshold_param, ang_threshold, default_ang_threshold);
 
+    std::string publish_individual_obstacles_param =
+    "publish_individual_obstacles";
+    bool default_publish_individual_obstacles = false;
+    SB_getParam(private_nh,
+                publish_individual_obstacles_param,
+                publish_individual_obstacles,
+                default_publish_individual_obstacles);
+
     std::string subscribe_topic =
     "/robot/laser/scan"; // Setup subscriber to laserscan (Placeholder)
     laser_subscriber = nh.subscribe(
     subscribe_topic, queue_size, &ConeExtractorNode::laserCallBack, this);
 
-    std::string output_cone_topic = "output_cone_obstacle"; // Placeholder
-    cone_publisher = private_nh.advertise<mapping_igvc::ConeObstacle>(
-    output_cone_topic, queue_size);
+    std::string output_cone_array_topic = "output_cone_obstacles";
+    cone_array_publisher =
+    private_nh.advertise<mapping_igvc::ConeObstacleArray>(
+    output_cone_array_topic, queue_size);
+
+    if (publish_individual_obstacles) {
+        std::string output_cone_topic = "output_cone_obstacle"; // Placeholder
+        cone_publisher = private_nh.advertise<mapping_igvc::ConeObstacle>(
+        output_cone_topic, queue_size);
+    }
+
+    std::string debug_rate_param = "debug_rate";
+    double default_debug_rate    = 10.0;
+    double debug_rate;
+    SB_getParam(private_nh, debug_rate_param, debug_rate, default_debug_rate);
 
     std::string marker_topic = "markers"; // Placeholder
-    rviz_publisher =
-    private_nh.advertise<visualization_msgs::Marker>(marker_topic, queue_size);
+    rviz_publisher.advertise(private_nh, marker_topic, debug_rate);
 }
 
 void ConeExtractorNode::laserCallBack(
@@ -67,39 +86,58 @@ const sensor_msgs::LaserScan::ConstPtr& ptr) {
                                       cone_rad_tol,
                                       min_points_in_cone,
                                       ang_threshold);
-    for (int i = 0; i < cones.size(); i++) { // Publish cones individually
-        cone_publisher.publish(cones[i]);
+
+    // One message per scan, even if it has no cones, so consumers can tell
+    // scans apart
+    mapping_igvc::ConeObstacleArray::Ptr cone_array(
+    new mapping_igvc::ConeObstacleArray());
+    cone_array->header = laser_msg.header;
+    cone_array->centers.reserve(cones.size());
+    cone_array->radii.reserve(cones.size());
+    for (int i = 0; i < cones.size(); i++) {
+        cone_array->centers.push_back(cones[i].center);
+        cone_array->radii.push_back(cones[i].radius);
+    }
+    cone_array_publisher.publish(cone_array);
+
+    if (publish_individual_obstacles) {
+        for (int i = 0; i < cones.size(); i++) {
+            cone_publisher.publish(cones[i]);
+        }
     }
-    publishMarkers(cones);
+    publishMarkers(std::move(cones));
 }
 
 void ConeExtractorNode::publishMarkers(
 std::vector<mapping_igvc::ConeObstacle> cones) {
     if (cones.empty()) return;
 
-    visualization_msgs::Marker marker;
+    // The marker is only built if someone is listening, off this thread
+    rviz_publisher.publish([cones = std::move(cones)] {
+        visualization_msgs::Marker marker;
 
-    marker.id                 = 0;
-    marker.header.frame_id    = cones[0].header.frame_id;
-    marker.action             = visualization_msgs::Marker::ADD;
-    marker.pose.orientation.w = 1.0;
+        marker.id                 = 0;
+        marker.header.frame_id    = cones[0].header.frame_id;
+        marker.action             = visualization_msgs::Marker::ADD;
+        marker.pose.orientation.w = 1.0;
 
-    marker.type = visualization_msgs::Marker::POINTS;
+        marker.type = visualization_msgs::Marker::POINTS;
 
-    // POINTS markers use x and y scale for width/height respectively
-    marker.scale.x = 0.1;
-    marker.scale.y = 0.1;
+        // POINTS markers use x and y scale for width/height respectively
+        marker.scale.x = 0.1;
+        marker.scale.y = 0.1;
 
-    // Points are green
-    marker.color.g = 1.0f;
-    marker.color.a = 1.0;
+        // Points are green
+        marker.color.g = 1.0f;
+        marker.color.a = 1.0;
 
-    for (int i = 0; i < cones.size(); i++) {
-        geometry_msgs::Point coneCenter;
-        coneCenter.x = cones[i].center.x;
-        coneCenter.y = cones[i].center.y;
-        marker.points.push_back(coneCenter);
-    }
+        for (int i = 0; i < cones.size(); i++) {
+            geometry_msgs::Point coneCenter;
+            coneCenter.x = cones[i].center.x;
+            coneCenter.y = cones[i].center.y;
+            marker.points.push_back(coneCenter);
+        }
 
-    rviz_publisher.publish(marker);
+        return marker;
+    });
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: Sets dynamic_reconfigure parameters of other nodes from a
+ *              background thread, with one set_parameters call per node
+ *              however many parameters change, so the caller never waits
+ *              on the nodes being reconfigured.
+ */
+#ifndef SB_POINTCLOUD_PROCESSING_ASYNCRECONFIGURECLIENT_H
+#define SB_POINTCLOUD_PROCESSING_ASYNCRECONFIGURECLIENT_H
+
+#include <condition_variable>
+#include <dynamic_reconfigure/Config.h>
+#include <map>
+#include <mutex>
+#include <ros/ros.h>
+#include <string>
+#include <thread>
+
+class AsyncReconfigureClient {
+  public:
+    /**
+     * Constructor
+     *
+     * @param service_timeout how long to wait for a node's set_parameters
+     * service to come up before giving up on an update
+     */
+    explicit AsyncReconfigureClient(
+    ros::WallDuration service_timeout = ros::WallDuration(1.0));
+
+    /**
+     * Waits for the update in flight, if any, and drops the queued ones
+     */
+    ~AsyncReconfigureClient();
+
+    AsyncReconfigureClient(const AsyncReconfigureClient&) = delete;
+    AsyncReconfigureClient& operator=(const AsyncReconfigureClient&) = delete;
+
+    /**
+     * Queues setting @params of @node_name in a single request. Parameters
+     * not in @params are left as they are. If an earlier update of the same
+     * node hasn't been sent yet, it is merged into this one.
+     *
+     * @param node_name the fully resolved name of the node to reconfigure
+     * @param params the names and new values of the parameters to set
+     */
+    void setParameters(const std::string& node_name,
+                       const std::map<std::string, double>& params);
+
+    /**
+     * @return true if there are updates queued or being sent
+     */
+    bool isBusy();
+
+  private:
+    void run();
+
+    /**
+     * Sends @params to @node_name, blocking until it is done
+     *
+     * @return true if the node accepted the update
+     */
+    bool send(const std::string& node_name,
+              const std::map<std::string, double>& params);
+
+    ros::WallDuration service_timeout;
+
+    // Updates waiting to be sent, by node
+    std::map<std::string, std::map<std::string, double>> pending;
+    bool sending;
+    bool stopped;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::thread worker;
+};
+
+#endif // SB_POINTCLOUD_PROCESSING_ASYNCRECONFIGURECLIENT_H
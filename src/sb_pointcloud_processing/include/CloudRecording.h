@@ -0,0 +1,167 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A compact on-disk format for recorded point clouds, so they
+ *              can be replayed through the line extractor without ROS.
+ *
+ *              Layout (all little endian, every block 64 byte aligned):
+ *                  Header       magic "SBCLOUD", version, number of frames,
+ *                               offset of the frame index
+ *                  Frame blocks for each frame, x y z floats for each point,
+ *                               followed by packed rgb if the cloud had it
+ *                  Frame index  one FrameIndexEntry per frame
+ *
+ *              CloudRecordingWriter appends frames and writes the index when
+ *              it is closed. CloudRecording maps a file into memory and hands
+ *              out frames that point straight into the mapping.
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_CLOUDRECORDING_H
+#define LINE_EXTRACTOR_IGVC_CLOUDRECORDING_H
+
+#include "PointCloudView.h"
+#include <cstdint>
+#include <cstdio>
+#include <sensor_msgs/PointCloud2.h>
+#include <string>
+#include <vector>
+
+namespace cloud_recording {
+static const char MAGIC[8]          = {'S', 'B', 'C', 'L', 'O', 'U', 'D', '\0'};
+static const uint32_t VERSION       = 1;
+static const size_t BLOCK_ALIGNMENT = 64;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_frames;
+    uint64_t index_offset;
+};
+
+struct FrameIndexEntry {
+    // header stamp of the recorded cloud, in seconds
+    double stamp;
+    // byte offsets of the xyz and rgb blocks, rgb is 0 if there is none
+    uint64_t xyz_offset;
+    uint64_t rgb_offset;
+    uint32_t num_points;
+    uint32_t seq;
+};
+}
+
+class CloudRecordingWriter {
+    std::FILE* _file = nullptr;
+
+    // the index is kept in memory and written out when closing
+    std::vector<cloud_recording::FrameIndexEntry> _index;
+
+    uint64_t _offset = 0;
+
+    // set when a partly written frame could not be removed again, after
+    // which the file and the index may disagree
+    bool _failed = false;
+
+    // reused between frames, so appending doesn't allocate
+    std::vector<float> _xyz;
+    std::vector<uint32_t> _rgb;
+
+  public:
+    CloudRecordingWriter() {}
+
+    ~CloudRecordingWriter();
+
+    CloudRecordingWriter(const CloudRecordingWriter&) = delete;
+    CloudRecordingWriter& operator=(const CloudRecordingWriter&) = delete;
+
+    /*
+     * Creates (or truncates) the recording at @path
+     * Returns false if the file could not be opened
+     */
+    bool open(const std::string& path);
+
+    /*
+     * Appends @cloud as the next frame. Points that aren't finite are
+     * dropped. The cloud needs float32 x and y fields, z and rgb are
+     * recorded if it has them. An rgb field that doesn't fit in a point is
+     * left out.
+     * A frame that is only partly written is truncated off the file again.
+     * If that fails too, the writer refuses any further frames.
+     * Returns false if the cloud could not be read or written
+     */
+    bool append(const sensor_msgs::PointCloud2& cloud);
+
+    /*
+     * Writes the frame index and closes the file. A recording that was never
+     * closed has no index and can't be read.
+     * Returns false if the index could not be written
+     */
+    bool close();
+
+    bool isOpen() const { return _file != nullptr; }
+
+    bool hasFailed() const { return _failed; }
+
+    size_t numFrames() const { return _index.size(); }
+
+  private:
+    bool write(const void* data, size_t size);
+
+    /*
+     * Cuts the file back to @offset, dropping a partly written frame
+     * Returns false, and marks the writer failed, if it couldn't be
+     */
+    bool truncate(uint64_t offset);
+
+    bool pad();
+};
+
+class CloudRecording {
+    const uint8_t* _data = nullptr;
+    size_t _size         = 0;
+
+    const cloud_recording::FrameIndexEntry* _index = nullptr;
+    uint32_t _num_frames                           = 0;
+
+  public:
+    /*
+     * A frame of the recording. The pointers point into the mapped file, and
+     * are only valid as long as the recording is open.
+     */
+    struct Frame {
+        double stamp;
+        uint32_t seq;
+        size_t num_points;
+        // x, y, z of each point back to back
+        const float* xyz;
+        // packed rgb of each point, or nullptr if the cloud had none
+        const uint32_t* rgb;
+
+        PointCloudView view() const { return PointCloudView(xyz, num_points); }
+    };
+
+    CloudRecording() {}
+
+    ~CloudRecording();
+
+    CloudRecording(const CloudRecording&) = delete;
+    CloudRecording& operator=(const CloudRecording&) = delete;
+
+    /*
+     * Maps the recording at @path into memory and checks its header and
+     * frame index
+     * Returns false if the file could not be mapped or isn't a valid
+     * recording
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    size_t numFrames() const { return _num_frames; }
+
+    /*
+     * Returns the @i-th frame, @i must be less than numFrames()
+     */
+    Frame frame(size_t i) const;
+};
+
+#endif // LINE_EXTRACTOR_IGVC_CLOUDRECORDING_H
@@ -0,0 +1,81 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A class which filters an RGB pointcloud by hue, saturation,
+ *              value and height in a single pass. Used in the
+ *              hsv_height_filter nodelet.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_COLOUR_HEIGHT_FILTER_H
+#define SB_POINTCLOUD_PROCESSING_COLOUR_HEIGHT_FILTER_H
+
+#include <Eigen/Geometry>
+#include <sensor_msgs/PointCloud2.h>
+
+#include <ColourspaceConverter.h>
+
+class ColourHeightFilter {
+  public:
+    ColourHeightFilter();
+
+    /**
+     * Filters the given cloud, keeping only the points whose hue, saturation,
+     * value and z all lie within the limits (inclusive). Points with
+     * non-finite coordinates are dropped.
+     *
+     * The input is read in place and needs float32 x, y and z fields and an
+     * rgb or rgba field. The output is an unorganized cloud of float32 x, y
+     * and z, laid out like pcl::PointXYZ. Its header is copied from the input.
+     *
+     * @param input the RGB pointcloud to filter
+     * @param output the message to write the surviving points to
+     * @return false if the input does not have the required fields, or its
+     * points don't fit within its data
+     */
+    bool filter(const sensor_msgs::PointCloud2& input,
+                sensor_msgs::PointCloud2& output) const;
+
+    /**
+     * Sets the range of hue (degrees) to keep
+     */
+    void setHueLimits(float min, float max);
+
+    /**
+     * Sets the range of saturation ([0, 1]) to keep
+     */
+    void setSaturationLimits(float min, float max);
+
+    /**
+     * Sets the range of value ([0, 1]) to keep
+     */
+    void setValueLimits(float min, float max);
+
+    /**
+     * Sets the range of z to keep, after the transform is applied
+     */
+    void setHeightLimits(float min, float max);
+
+    /**
+     * Sets a transform that is applied to every point before its height is
+     * checked. The output points are in the transformed frame.
+     *
+     * @param transform transform from the input frame to the output frame
+     */
+    void setTransform(const Eigen::Affine3f& transform);
+
+    /**
+     * Removes the transform set by setTransform
+     */
+    void clearTransform();
+
+  private:
+    float h_min_, h_max_;
+    float s_min_, s_max_;
+    float v_min_, v_max_;
+    float z_min_, z_max_;
+
+    bool has_transform_;
+    Eigen::Affine3f transform_;
+};
+
+#endif // SB_POINTCLOUD_PROCESSING_COLOUR_HEIGHT_FILTER_H
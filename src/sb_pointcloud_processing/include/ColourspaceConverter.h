@@ -23,6 +23,16 @@ class ColourspaceConverter {
      */
     void convert(pcl::PointCloud<pcl::PointXYZHSV>& output);
 
+    /**
+     * Converts the pointcloud given by setInputCloud to an
+     * HSV colourspace, 8 points at a time with SSE2 or AVX2 when the CPU
+     * supports it, falling back to PointXYZRGBAtoXYZHSV otherwise.
+     * Results match PointXYZRGBAtoXYZHSV to within float rounding.
+     * @param output memory allocated to store the output cloud, resized to
+     * fit the input cloud
+     */
+    void convertBatch(pcl::PointCloud<pcl::PointXYZHSV>& output);
+
     /**
      * Sets the input cloud to be processed
      * @param input
@@ -39,6 +49,19 @@ class ColourspaceConverter {
     void PointXYZRGBAtoXYZHSV(const pcl::PointXYZRGB& in,
                               pcl::PointXYZHSV& out);
 
+    /**
+     * Converts an RGB colour to the HSV colourspace, with the same
+     * conventions as PointXYZRGBAtoXYZHSV (h in [0, 360), s and v in [0, 1])
+     * @param r, g, b the colour to convert
+     * @param h, s, v the corresponding colour in HSV colourspace
+     */
+    static void rgbToHsv(unsigned char r,
+                         unsigned char g,
+                         unsigned char b,
+                         float& h,
+                         float& s,
+                         float& v);
+
   private:
     pcl::PointCloud<pcl::PointXYZRGB>::Ptr cloud_;
 };
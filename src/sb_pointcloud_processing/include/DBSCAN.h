@@ -7,6 +7,7 @@
 #ifndef LINE_EXTRACTOR_IGVC_DBSCAN_H
 #define LINE_EXTRACTOR_IGVC_DBSCAN_H
 
+#include "PointCloudView.h"
 #include <pcl/PCLPointCloud2.h>
 #include <pcl/conversions.h>
 #include <pcl/point_types.h>
@@ -17,9 +18,11 @@ using namespace std::tr1;
 
 class DBSCAN {
     /*
-     * This variable stores the PointCloud input that we want to cluster
+     * This variable is a view of the PointCloud input that we want to
+     * cluster. The input itself is not copied, so it must stay alive while
+     * clustering.
      */
-    pcl::PointCloud<pcl::PointXYZ> _pcl;
+    PointCloudView _pcl;
 
     /*
      * This variable stores the PointCloud clusters output
@@ -66,6 +69,13 @@ class DBSCAN {
     vector<pcl::PointCloud<pcl::PointXYZ>>
     findClusters(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
 
+    /*
+     * Same as above, but reads the points through a view, e.g. straight out
+     * of the buffer of a PointCloud2 message
+     */
+    vector<pcl::PointCloud<pcl::PointXYZ>>
+    findClusters(const PointCloudView& pcl_view);
+
     void setMinNeighbours(int new_min_neighour);
     void setRadius(float new_radius);
 
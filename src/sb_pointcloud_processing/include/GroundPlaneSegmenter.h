@@ -0,0 +1,197 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A class which estimates the ground plane of a pointcloud with
+ *              RANSAC, warm started from the plane of the previous cloud, and
+ *              keeps the points within a band of signed distances from it.
+ *              Used in the ground_plane_filter nodelet.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_GROUND_PLANE_SEGMENTER_H
+#define SB_POINTCLOUD_PROCESSING_GROUND_PLANE_SEGMENTER_H
+
+#include <Eigen/Geometry>
+#include <random>
+#include <sensor_msgs/PointCloud2.h>
+#include <vector>
+
+class GroundPlaneSegmenter {
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /**
+     * @param inlier_threshold max distance (m) from a plane for a sample to
+     * count as an inlier
+     * @param max_tilt max angle (rad) between the normal of the plane and z
+     * @param max_samples max number of points the plane is estimated from
+     * @param max_iterations max number of planes tried per cloud
+     * @param time_budget_ms max time spent trying planes per cloud
+     * @param seed seed of the random number generator
+     */
+    GroundPlaneSegmenter(float inlier_threshold      = 0.03,
+                         float max_tilt              = 0.35,
+                         unsigned int max_samples    = 500,
+                         unsigned int max_iterations = 100,
+                         float time_budget_ms        = 2,
+                         unsigned int seed           = 123);
+
+    /**
+     * Estimates the ground plane of the given cloud from a subsample of its
+     * points, then keeps the points whose signed distance to the plane
+     * (positive above it) lies within the band (inclusive). Points with
+     * non-finite coordinates are dropped.
+     *
+     * The input is read in place and needs float32 x, y and z fields. The
+     * output has the same fields as the input, and is unorganized. Its
+     * header is copied from the input.
+     *
+     * @param input the pointcloud to segment
+     * @param output the message to write the surviving points to
+     * @return false if the input does not have the required fields, or its
+     * points don't fit within its data
+     */
+    bool segment(const sensor_msgs::PointCloud2& input,
+                 sensor_msgs::PointCloud2& output);
+
+    /**
+     * Updates the plane from a subsample of the points of the given cloud,
+     * as segment does, without filtering it. Lets the plane be estimated from
+     * a different cloud than the one filtered, such as the whole cloud when
+     * only some colours are filtered.
+     *
+     * @param input the pointcloud to estimate the plane from
+     * @return false if the input does not have the required fields, or its
+     * points don't fit within its data
+     */
+    bool updatePlane(const sensor_msgs::PointCloud2& input);
+
+    /**
+     * Keeps the points of the given cloud within the band around the current
+     * plane, as segment does, without updating the plane
+     *
+     * @param input the pointcloud to filter
+     * @param output the message to write the surviving points to
+     * @return false if the input does not have the required fields, or its
+     * points don't fit within its data
+     */
+    bool filter(const sensor_msgs::PointCloud2& input,
+                sensor_msgs::PointCloud2& output) const;
+
+    /**
+     * Updates the plane from the given points. The current plane is scored
+     * first, so if it still fits only a few random planes are tried.
+     * The plane is left as is if no plane with enough inliers is found.
+     *
+     * @param points points in the output frame
+     * @return true if the plane was updated
+     */
+    bool estimatePlane(const std::vector<Eigen::Vector3f>& points);
+
+    /**
+     * Sets the range of signed distances from the plane to keep
+     */
+    void setBand(float min, float max);
+
+    /**
+     * Sets the minimum fraction of the samples that need to be inliers for
+     * a plane to be accepted
+     */
+    void setMinInlierRatio(float min_inlier_ratio);
+
+    /**
+     * Sets a transform that is applied to every point before anything else.
+     * The output points are in the transformed frame.
+     *
+     * @param transform transform from the input frame to the output frame
+     */
+    void setTransform(const Eigen::Affine3f& transform);
+
+    /**
+     * Removes the transform set by setTransform
+     */
+    void clearTransform();
+
+    /**
+     * The current plane (a, b, c, d), with ax + by + cz + d = 0, (a, b, c)
+     * a unit normal and c > 0
+     */
+    const Eigen::Vector4f& plane() const;
+
+    /**
+     * Forgets the current plane, going back to z = 0
+     */
+    void reset();
+
+  private:
+    /**
+     * Finds the offsets of the x, y and z fields of a cloud, and checks that
+     * every point lies within its data
+     *
+     * @return false if a field is missing or the cloud is malformed
+     */
+    bool findFields(const sensor_msgs::PointCloud2& input,
+                    int& x_offset,
+                    int& y_offset,
+                    int& z_offset) const;
+
+    /**
+     * Reads the point at @ptr, applying the transform
+     *
+     * @return false if the point is not finite
+     */
+    bool readPoint(const uint8_t* ptr,
+                   int x_offset,
+                   int y_offset,
+                   int z_offset,
+                   Eigen::Vector3f& point) const;
+
+    /**
+     * MSAC cost of a plane: the sum over all points of their squared
+     * distance to the plane, capped at the squared inlier threshold
+     */
+    float cost(const Eigen::Vector4f& plane,
+               const std::vector<Eigen::Vector3f>& points,
+               unsigned int& num_inliers) const;
+
+    /**
+     * Fits a plane to the inliers of @plane with least squares
+     *
+     * @return false if the fitted plane is too tilted or degenerate
+     */
+    bool refine(const std::vector<Eigen::Vector3f>& points,
+                Eigen::Vector4f& plane) const;
+
+    /**
+     * Number of planes that need to be tried to find one free of outliers
+     * with 99% confidence, given the fraction of inliers
+     */
+    unsigned int requiredIterations(double inlier_ratio) const;
+
+    /**
+     * Orients a plane so its normal points up, and checks its tilt
+     *
+     * @return false if the plane is too tilted
+     */
+    bool orient(Eigen::Vector4f& plane) const;
+
+    Eigen::Vector4f plane_;
+
+    float inlier_threshold_;
+    float min_cos_tilt_;
+    unsigned int max_samples_;
+    unsigned int max_iterations_;
+    float time_budget_ms_;
+    float min_inlier_ratio_;
+
+    float min_distance_, max_distance_;
+
+    bool has_transform_;
+    Eigen::Affine3f transform_;
+
+    std::mt19937 generator_;
+
+    // Subsample of the cloud, kept between clouds so its memory is reused
+    std::vector<Eigen::Vector3f> samples_;
+};
+
+#endif // SB_POINTCLOUD_PROCESSING_GROUND_PLANE_SEGMENTER_H
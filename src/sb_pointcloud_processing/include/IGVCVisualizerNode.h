@@ -6,18 +6,22 @@
  * References:
  *      Tutorial for pcl_visualizer -
  *          http://pointclouds.org/documentation/tutorials/pcl_visualizer.php
- *      Dynamic Reconfigure for C++ -
- *          http://wiki.ros.org/hokuyo_node/Tutorials/UsingDynparamToChangeHokuyoLaserParameters#PythonAPI
+ *      Dynamic Reconfigure -
+ *          http://wiki.ros.org/dynamic_reconfigure
  */
 #ifndef SB_POINTCLOUD_PROCESSING_IGVCVISUALIZERNODE_H
 #define SB_POINTCLOUD_PROCESSING_IGVCVISUALIZERNODE_H
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <mutex>
 
 // Pointcloud
 #include <pcl/common/common_headers.h>
 #include <pcl/filters/filter.h>
+#include <pcl/filters/voxel_grid.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl/point_types.h>
 #include <pcl/visualization/pcl_visualizer.h>
@@ -25,12 +29,16 @@
 
 // ROS
 #include <nodelet/nodelet.h>
+#include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <sensor_msgs/PointCloud2.h>
 
 // Colour Space Conversions
 #include "ColourspaceConverter.h"
 
+// Reconfiguring the filters
+#include "AsyncReconfigureClient.h"
+
 // Snowbots
 #include "sb_utils.h"
 
@@ -43,26 +51,56 @@ class IGVCVisualizerNode {
 
   private:
     /**
-     * Callback for the raw pointcloud
+     * Callback for the raw pointcloud, keeps it until the next update of
+     * the viewer, replacing any cloud that hasn't been shown yet
      *
      * @param address of raw point cloud
      */
     void rawPCLCallBack(const sensor_msgs::PointCloud2::ConstPtr& input);
 
     /**
-     * Callback for the filtered pointcloud
+     * Callback for the filtered pointcloud, keeps it until the next update of
+     * the viewer, replacing any cloud that hasn't been shown yet
      *
      * @param address of filtered point cloud
      */
     void filteredPCLCallBack(const sensor_msgs::PointCloud2::ConstPtr& input);
 
+    /**
+     * Converts @input to a PCL pointcloud without NaNs, averaging the points
+     * in each voxel_size cube if voxel_size is positive
+     *
+     * @param input the pointcloud to convert
+     * @return the pointcloud to be displayed
+     */
+    template <typename PointT>
+    typename pcl::PointCloud<PointT>::ConstPtr
+    prepareCloud(const sensor_msgs::PointCloud2& input);
+
+    /**
+     * Shows @cloud in @channel, replacing the points of the cloud
+     * with the same @id if there is one
+     *
+     * @param cloud the pointcloud to show
+     * @param colour how to colour the points
+     * @param id the name of the pointcloud in the viewer
+     * @param channel the viewport to show it in
+     */
+    template <typename PointT>
+    void showPointCloud(
+    const typename pcl::PointCloud<PointT>::ConstPtr& cloud,
+    const pcl::visualization::PointCloudColorHandler<PointT>& colour,
+    const std::string& id,
+    int channel);
+
     /**
      * Initialization of the filter
      */
     boost::shared_ptr<pcl::visualization::PCLVisualizer> setUpPCLVisualizer();
 
     /**
-     * Whenever a timer event occurs, the image is updated
+     * Whenever a timer event occurs, the image is updated with the latest
+     * clouds received
      *
      * @param event timer based event based on image_update_rate
      */
@@ -105,6 +143,9 @@ class IGVCVisualizerNode {
      * Min and maxes for the filter are determined by the passed in h, s, and v
      * values and the set margin of errors.
      *
+     * Returns straight away, the filters are updated in the background with
+     * one request per filter node.
+     *
      * @param h hue
      * @param s saturation
      * @param v value
@@ -112,18 +153,29 @@ class IGVCVisualizerNode {
     static void updateFilterParams(float h, float s, float v);
 
     /**
-     * Run command line arguments to dynamically reconfigure a node parameter
+     * Finds the point of raw_picking_cloud nearest to @point, only done when
+     * a point is picked so the shown clouds can stay decimated
      *
-     * @param node_name name of the node to reconfigure
-     * @param param_name name of the parameter to reconfigure
-     * @param val new value of the parameter
+     * @param point the point picked in the decimated cloud
+     * @return the nearest raw point, or @point if there are none
      */
-    static void
-    setParameter(std::string node_name, std::string param_name, float val);
+    static pcl::PointXYZRGB findNearestRawPoint(const pcl::PointXYZRGB& point);
+
+    // Clouds are received on their own thread so they never wait on the
+    // viewer, which has to stay on the main thread
+    ros::CallbackQueue intake_queue;
 
     ros::Subscriber raw_pcl_sub;
     ros::Subscriber filtered_pcl_sub;
 
+    // The latest clouds received that haven't been shown yet
+    std::mutex latest_mutex;
+    sensor_msgs::PointCloud2::ConstPtr latest_raw_cloud;
+    sensor_msgs::PointCloud2::ConstPtr latest_filtered_cloud;
+
+    // Destroyed first, so the callbacks stop before anything they use goes
+    boost::shared_ptr<ros::AsyncSpinner> intake_spinner;
+
     // Viewport Channels
     int raw_channel;
     int filtered_channel;
@@ -132,19 +184,35 @@ class IGVCVisualizerNode {
     ros::Timer timer;
     float image_update_rate;
 
+    // Size of the cubes clouds are decimated into before being shown,
+    // 0 shows every point
+    float voxel_size;
+
     // Margin of Error Variables
     static float h_margin_of_error;
     static float s_margin_of_error;
     static float v_margin_of_error;
 
     // Determines whether or not viewer should be updated
-    static bool isPaused;
+    static std::atomic<bool> isPaused;
+
+    // Whether the filters are the single hsv_height_filter, or separate
+    // hue_filter, saturation_filter and value_filter PassThrough nodelets
+    static bool fused_filter;
+
+    // Sends the new filter parameters without blocking the viewer
+    static boost::shared_ptr<AsyncReconfigureClient> reconfigure_client;
 
     // The viewer object that controls the pcl visualizer
     static boost::shared_ptr<pcl::visualization::PCLVisualizer> viewer;
 
     // The point cloud to be displayed onto the raw_channel
-    static pcl::PointCloud<pcl::PointXYZRGB>::Ptr raw_visualized_cloud;
+    static pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr raw_visualized_cloud;
+
+    // The raw cloud raw_visualized_cloud was decimated from, if it was, so
+    // picked points take the colour of a real point instead of a voxel's
+    // average
+    static sensor_msgs::PointCloud2::ConstPtr raw_picking_cloud;
 };
 
 #endif // SB_POINTCLOUD_PROCESSING_IGVCVISUALIZERNODE_H
@@ -8,10 +8,15 @@
 #define LINE_EXTRACTOR_IGVC_NODE_H
 
 #include "DBSCAN.h"
+#include "LineTracker.h"
+#include "RansacRegression.h"
 #include "Regression.h"
+#include "VoxelGridDownsampler.h"
+#include <DebugPublisher.h>
 #include <RvizUtils.h>
 #include <iostream>
 #include <mapping_igvc/LineObstacle.h>
+#include <mapping_igvc/LineObstacleArray.h>
 #include <math.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
@@ -29,7 +34,18 @@ class LineExtractorNode {
      */
     std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
 
-    LineExtractorNode(int argc, char** argv, std::string node_name);
+    /*
+     * @nh: node handle to subscribe to the input pointcloud on
+     * @private_nh: node handle to get params from and publish on
+     * Used both by the standalone node and by the line_extractor nodelet
+     */
+    LineExtractorNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
+    /*
+     * false if the params were invalid, in which case the node neither
+     * subscribes nor publishes
+     */
+    bool isValid() const { return valid; }
 
     // main entry function
     void extractLines();
@@ -44,15 +60,35 @@ class LineExtractorNode {
      * and @colors.
      */
     static void convertClustersToPointsWithColors(
-    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters,
+    const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
     std::vector<geometry_msgs::Point>& cluster_points,
     std::vector<std_msgs::ColorRGBA>& colors);
 
   private:
+    bool valid;
+
     ros::Subscriber subscriber;
+    ros::Publisher array_publisher;
     ros::Publisher publisher;
-    ros::Publisher rviz_line_publisher;
-    ros::Publisher rviz_cluster_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker> rviz_line_publisher;
+    snowbots::DebugPublisher<visualization_msgs::Marker> rviz_cluster_publisher;
+
+    /*
+     * @downsampler thins out the input pointcloud before it is clustered,
+     * so the cost of clustering is bounded by its point budget
+     */
+    VoxelGridDownsampler downsampler;
+
+    /*
+     * @downsampled holds the output of @downsampler. Kept between callbacks
+     * so its memory is reused
+     */
+    pcl::PointCloud<pcl::PointXYZ> downsampled;
+
+    /*
+     * @downsample is true if either a cell size or a point budget is set
+     */
+    bool downsample;
 
     /*
      * @regression takes in the output from @dbscan and outputs a LineObstacle
@@ -62,6 +98,46 @@ class LineExtractorNode {
      */
     Regression regression;
 
+    /*
+     * @ransac_regression is used instead of @regression when
+     * @robustFitting is set. It fits a line to the inliers of each cluster,
+     * so stray points picked up by DBSCAN don't drag the line off.
+     */
+    RansacRegression ransac_regression;
+
+    /*
+     * @robustFitting determines whether lines are fit with
+     * @ransac_regression (true) or plain least squares @regression (false)
+     */
+    bool robustFitting;
+
+    /*
+     * @ransacMaxIterations and @ransacTimeBudget bound the samples
+     * @ransac_regression draws per cluster, kept to check they're positive
+     */
+    int ransacMaxIterations;
+    float ransacTimeBudget;
+
+    /*
+     * @publishIndividualObstacles determines whether each line is also
+     * published as its own LineObstacle message, for consumers that
+     * haven't moved to LineObstacleArray
+     */
+    bool publishIndividualObstacles;
+
+    /*
+     * @line_tracker follows lines across frames when @tracking is set, so
+     * frames it can verify skip clustering and fitting, and the lines
+     * published are Kalman filtered
+     */
+    LineTracker line_tracker;
+
+    /*
+     * @tracking determines whether the lines published are the tracks of
+     * @line_tracker (true) or the lines fitted to each frame (false)
+     */
+    bool tracking;
+
     /*
      * @degreePoly is a hyperparameter to regression that determines
      * the degree of polynomial of the line of best fit
@@ -105,41 +181,52 @@ class LineExtractorNode {
     std::string frame_id;
 
     /*
-     * @pclPtr stores the pointer to the PCL PointCloud after it has
-     * been converted from sensor_msgs PointCloud2
+     * @pclMsg keeps the latest PointCloud2 message alive while it is being
+     * processed, since DBSCAN reads the points straight out of its buffer
      */
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pclPtr;
+    sensor_msgs::PointCloud2ConstPtr pclMsg;
 
     /*
      * The callback function is called whenever the node receives a
-     * PointCloud message. It converts sensor_msgs PointCloud2 pointer
-     * to PCL PointCloud pointer and then extracts lines from the PointCloud
+     * PointCloud message. It stores the message and then extracts lines from
+     * it, reading x and y in place without converting the message.
      */
     void pclCallBack(const sensor_msgs::PointCloud2ConstPtr processed_pcl);
 
     /*
      * @line_obstacles a list of LineObstacle messages
      * This function takes in @line_obstacles and publishes a message
-     * to rviz for visualization at "~/debug/output_line_obstacle".
+     * to rviz for visualization at "~/debug/output_line_obstacle", if
+     * anyone is subscribed to it.
      */
     void visualizeLineObstacles(
     std::vector<mapping_igvc::LineObstacle> line_obstacles);
 
+    /*
+     * Publishes @line_obstacles as a single LineObstacleArray (and each of
+     * them on its own if @publishIndividualObstacles is set), along with the
+     * rviz markers of @clusters and @line_obstacles
+     */
+    void publishLines(std::vector<mapping_igvc::LineObstacle> line_obstacles);
+
     /*
      * This function makes a Marker for all points in @clusters
      * with a different color for each cluster and publishes a message
-     * to rviz for visualization at "~/debug/clusters".
+     * to rviz for visualization at "~/debug/clusters", if anyone is
+     * subscribed to it.
      */
     void visualizeClusters();
 
     /*
      * @line_obstacles: list of line obstacle messages
+     * @x_delta: distance along x between the points of a line
      * This function converts each line obstacle into a list of
      * geometry_msgs:Point and then merges all of them into a single
      * vector.
      */
-    std::vector<geometry_msgs::Point> convertLineObstaclesToPoints(
-    std::vector<mapping_igvc::LineObstacle> line_obstacles);
+    static std::vector<geometry_msgs::Point> convertLineObstaclesToPoints(
+    const std::vector<mapping_igvc::LineObstacle>& line_obstacles,
+    float x_delta);
 
     /*
      * Convert a list of vectors to a list of LineObstacle message
@@ -147,6 +234,11 @@ class LineExtractorNode {
     std::vector<mapping_igvc::LineObstacle>
     vectorsToMsgs(std::vector<Eigen::VectorXf> vectors);
 
+    /*
+     * Convert the tracks of @line_tracker to a list of LineObstacle message
+     */
+    std::vector<mapping_igvc::LineObstacle> tracksToMsgs();
+
     /*
      * Convert a vector to LineObstacle message
      */
@@ -163,7 +255,8 @@ class LineExtractorNode {
     /*
      * Checks whether or not all the params we are getting from NodeHandler are
      * valid
-     * params being checked: degree_polynomial, lambda, min_neighbours, radius
+     * params being checked: degree_polynomial, lambda, min_neighbours, radius,
+     * ransac_max_iterations, ransac_time_budget_ms
      */
     bool areParamsInvalid();
 };
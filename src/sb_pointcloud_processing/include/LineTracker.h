@@ -0,0 +1,136 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class declaration for LineTracker, which keeps lines found in
+ *              previous frames as Kalman filtered tracks, and checks them
+ *              against each new frame so that clustering only has to be redone
+ *              when the scene changes
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_LINETRACKER_H
+#define LINE_EXTRACTOR_IGVC_LINETRACKER_H
+
+#include "PointCloudView.h"
+#include <Eigen/Dense>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <vector>
+
+class LineTracker {
+  public:
+    /*
+     * A line followed across frames
+     */
+    struct Track {
+        /*
+         * Filtered polynomial coefficients, lowest degree first, and their
+         * covariance
+         */
+        Eigen::VectorXf coefficients;
+        Eigen::MatrixXf covariance;
+
+        float x_min;
+        float x_max;
+
+        /*
+         * Number of frames in a row the line was not seen in
+         */
+        unsigned int misses;
+    };
+
+    /*
+     * Constructor:
+     * @poly_degree: degree of the polynomial of the lines
+     * @inlier_threshold: max vertical distance from a track for a point to
+     * belong to it
+     * @min_inliers: min number of points a track needs to be verified
+     * @max_unexplained_ratio: max fraction of points that may belong to no
+     * track for a frame to be verified
+     * @process_noise: standard deviation the coefficients drift by per frame
+     * @measurement_noise: standard deviation of the fitted coefficients
+     * @max_misses: number of frames in a row a track may go unseen before
+     * it is dropped
+     */
+    LineTracker(unsigned int poly_degree    = 3,
+                float inlier_threshold      = 0.05,
+                unsigned int min_inliers    = 30,
+                float max_unexplained_ratio = 0.2,
+                float process_noise         = 0.01,
+                float measurement_noise     = 0.05,
+                unsigned int max_misses     = 2);
+
+    /*
+     * Checks the tracks against a new frame by counting the points near each
+     * predicted line, which is much cheaper than clustering the frame.
+     * If every track has at least @_min_inliers points and at most
+     * @_max_unexplained_ratio of the points belong to no track, each track is
+     * updated with the line fitted to its points and true is returned.
+     * Otherwise the tracks are left as they are and the frame needs to go
+     * through clustering.
+     */
+    bool verify(const PointCloudView& pcl_view, float lambda = 0);
+
+    /*
+     * Updates the tracks with the lines found by clustering a frame. Each
+     * line is matched to the closest track, which is Kalman updated with it.
+     * Lines that match no track start new tracks, and tracks that match no
+     * line are dropped once they have been missed @_max_misses times in a
+     * row.
+     * @lines: lines of best fit, lines[i] being the line of clusters[i]
+     */
+    void update(const std::vector<Eigen::VectorXf>& lines,
+                const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters);
+
+    const std::vector<Track>& getTracks() const { return _tracks; }
+
+    /*
+     * The points that belonged to each track in the last verified frame
+     */
+    const std::vector<pcl::PointCloud<pcl::PointXYZ>>& getInliers() const {
+        return _inliers;
+    }
+
+    void clear();
+
+  private:
+    unsigned int _poly_degree;
+    float _inlier_threshold;
+    unsigned int _min_inliers;
+    float _max_unexplained_ratio;
+    float _process_noise;
+    float _measurement_noise;
+    unsigned int _max_misses;
+
+    std::vector<Track> _tracks;
+
+    /*
+     * Points of each track, kept between frames so their memory is reused
+     */
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> _inliers;
+
+    /*
+     * Grows the covariance of every track by the process noise
+     */
+    void predict();
+
+    /*
+     * Kalman update of @track with a measured line and its x range
+     */
+    void correct(Track& track,
+                 const Eigen::VectorXf& measurement,
+                 float x_min,
+                 float x_max) const;
+
+    /*
+     * Mean vertical distance between a track and a line over the x range
+     * they share, or a negative number if they don't overlap
+     */
+    static float distance(const Track& track,
+                          const Eigen::VectorXf& line,
+                          float x_min,
+                          float x_max);
+
+    static float evaluate(const Eigen::VectorXf& coefficients, float x);
+};
+
+#endif // LINE_EXTRACTOR_IGVC_LINETRACKER_H
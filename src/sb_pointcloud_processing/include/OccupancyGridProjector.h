@@ -0,0 +1,100 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class declaration for OccupancyGridProjector, which projects
+ *              the points of a PointCloud onto a 2D occupancy grid, and marks
+ *              the cells between the sensor and each obstacle as free
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_OCCUPANCYGRIDPROJECTOR_H
+#define LINE_EXTRACTOR_IGVC_OCCUPANCYGRIDPROJECTOR_H
+
+#include "PointCloudView.h"
+#include <Eigen/Geometry>
+#include <cstdint>
+#include <vector>
+
+class OccupancyGridProjector {
+  public:
+    /*
+     * Values of the cells of the output grid, matching what PathFinderNode
+     * expects
+     */
+    static const int8_t GRID_FREE     = 0;
+    static const int8_t GRID_OCCUPIED = 100;
+
+    /*
+     * Constructor:
+     * Takes in the size of the grid in cells, the side length of a cell,
+     * and the value given to cells that are neither seen as occupied nor
+     * as free. PathFinderNode treats every non free cell as blocked, so
+     * unknown cells are free by default; use -1 for nav_msgs semantics.
+     */
+    OccupancyGridProjector(unsigned int width   = 200,
+                           unsigned int height  = 200,
+                           float resolution     = 0.05,
+                           int8_t unknown_value = GRID_FREE);
+
+    /*
+     * Main entry function:
+     * Fills @grid (row major, @_width x @_height) from @cloud.
+     * @transform takes the points into the grid frame, @grid_origin is the
+     * position of the corner of cell (0, 0) and @sensor_origin the position
+     * of the sensor, both in the grid frame.
+     * Every cell containing a point is occupied, the cells crossed by the
+     * ray from the sensor to an occupied cell are free, and the rest are
+     * @_unknown_value.
+     */
+    void project(const PointCloudView& cloud,
+                 const Eigen::Affine3f& transform,
+                 const Eigen::Vector2f& grid_origin,
+                 const Eigen::Vector2f& sensor_origin,
+                 std::vector<int8_t>& grid);
+
+    unsigned int width() const { return _width; }
+    unsigned int height() const { return _height; }
+    float resolution() const { return _resolution; }
+
+  private:
+    /*
+     * States of the cells of the partial grids
+     */
+    enum CellState : uint8_t { UNKNOWN = 0, FREE = 1, OCCUPIED = 2 };
+
+    unsigned int _width;
+    unsigned int _height;
+    float _resolution;
+    int8_t _unknown_value;
+
+    /*
+     * One partial grid per thread, so threads bin points and cast rays
+     * without sharing writes. Merged into @_occupied and the output once
+     * each pass is done, and kept between calls so their memory is reused.
+     */
+    std::vector<std::vector<uint8_t>> _partial_grids;
+
+    /*
+     * true for each cell hit by at least one point
+     */
+    std::vector<uint8_t> _occupied;
+
+    /*
+     * Indices of the occupied cells, the ends of the rays to cast
+     */
+    std::vector<int> _occupied_cells;
+
+    unsigned int _sequential_cut_off = 1000;
+
+    /*
+     * Marks the cells from (@x0, @y0) up to but not including (@x1, @y1)
+     * as free in @partial_grid, skipping those outside the grid
+     */
+    void castRay(int x0, int y0, int x1, int y1, uint8_t* partial_grid) const;
+
+    /*
+     * Makes sure there is a cleared partial grid for every thread
+     */
+    void preparePartialGrids();
+};
+
+#endif // LINE_EXTRACTOR_IGVC_OCCUPANCYGRIDPROJECTOR_H
@@ -0,0 +1,159 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A read-only view of the x, y and z of the points in a
+ *              sensor_msgs PointCloud2, a PCL PointCloud or a packed xyz
+ *              array, without copying or converting the underlying data
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_POINTCLOUDVIEW_H
+#define LINE_EXTRACTOR_IGVC_POINTCLOUDVIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <sensor_msgs/PointCloud2.h>
+
+class PointCloudView {
+    /*
+     * Start of the point data, which must outlive the view
+     */
+    const uint8_t* _data = nullptr;
+
+    uint32_t _width      = 0;
+    uint32_t _height     = 0;
+    uint32_t _point_step = 0;
+    uint32_t _row_step   = 0;
+
+    /*
+     * true if rows are packed back to back, so the i-th point is simply
+     * i * @_point_step bytes in
+     */
+    bool _is_contiguous = true;
+
+    /*
+     * Byte offsets of x, y and z within a point. z is optional, and read as
+     * 0 if the cloud doesn't have it (@_z_offset < 0)
+     */
+    int _x_offset = 0;
+    int _y_offset = 0;
+    int _z_offset = -1;
+
+  public:
+    /*
+     * Constructor:
+     * An empty view
+     */
+    PointCloudView() {}
+
+    /*
+     * Constructor:
+     * A view of a PointCloud2 message. The message must have float32 x and y
+     * fields, and every point must lie within its data, otherwise the view
+     * is empty.
+     */
+    explicit PointCloudView(const sensor_msgs::PointCloud2& cloud) {
+        int x_offset = -1, y_offset = -1, z_offset = -1;
+        for (const sensor_msgs::PointField& field : cloud.fields) {
+            if (field.datatype != sensor_msgs::PointField::FLOAT32) continue;
+            if (field.name == "x") x_offset = field.offset;
+            if (field.name == "y") y_offset = field.offset;
+            if (field.name == "z") z_offset = field.offset;
+        }
+        if (x_offset < 0 || y_offset < 0 || cloud.data.empty()) { return; }
+
+        // A truncated or inconsistent cloud would be read past its end
+        uint64_t field_end =
+        std::max(std::max(x_offset, y_offset), z_offset) + sizeof(float);
+        if ((uint64_t) cloud.height * cloud.row_step > cloud.data.size() ||
+            (uint64_t) cloud.width * cloud.point_step > cloud.row_step ||
+            field_end > cloud.point_step) {
+            return;
+        }
+
+        _data          = cloud.data.data();
+        _width         = cloud.width;
+        _height        = cloud.height;
+        _point_step    = cloud.point_step;
+        _row_step      = cloud.row_step;
+        _is_contiguous = cloud.row_step == cloud.width * cloud.point_step;
+        _x_offset      = x_offset;
+        _y_offset      = y_offset;
+        _z_offset      = z_offset;
+    }
+
+    /*
+     * Constructor:
+     * A view of a PCL PointCloud
+     */
+    explicit PointCloudView(const pcl::PointCloud<pcl::PointXYZ>& cloud) {
+        if (cloud.empty()) { return; }
+
+        _data       = reinterpret_cast<const uint8_t*>(cloud.points.data());
+        _width      = cloud.size();
+        _height     = 1;
+        _point_step = sizeof(pcl::PointXYZ);
+        _row_step   = _width * _point_step;
+        _x_offset   = offsetof(pcl::PointXYZ, x);
+        _y_offset   = offsetof(pcl::PointXYZ, y);
+        _z_offset   = offsetof(pcl::PointXYZ, z);
+    }
+
+    /*
+     * Constructor:
+     * A view of @num_points points stored back to back as x, y, z floats,
+     * e.g. a frame of a CloudRecording
+     */
+    PointCloudView(const float* xyz, size_t num_points) {
+        if (xyz == nullptr || num_points == 0) { return; }
+
+        _data       = reinterpret_cast<const uint8_t*>(xyz);
+        _width      = num_points;
+        _height     = 1;
+        _point_step = 3 * sizeof(float);
+        _row_step   = _width * _point_step;
+        _x_offset   = 0;
+        _y_offset   = sizeof(float);
+        _z_offset   = 2 * sizeof(float);
+    }
+
+    /*
+     * Number of points in the view
+     */
+    size_t size() const { return (size_t) _width * _height; }
+
+    bool empty() const { return size() == 0; }
+
+    float x(size_t i) const { return readFloat(i, _x_offset); }
+
+    float y(size_t i) const { return readFloat(i, _y_offset); }
+
+    float z(size_t i) const {
+        return _z_offset < 0 ? 0.f : readFloat(i, _z_offset);
+    }
+
+    /*
+     * Returns a copy of the i-th point
+     */
+    pcl::PointXYZ operator[](size_t i) const {
+        return pcl::PointXYZ(x(i), y(i), z(i));
+    }
+
+  private:
+    const uint8_t* pointData(size_t i) const {
+        if (_is_contiguous) { return _data + i * _point_step; }
+        return _data + (i / _width) * _row_step + (i % _width) * _point_step;
+    }
+
+    float readFloat(size_t i, int offset) const {
+        // memcpy, since fields aren't guaranteed to be aligned
+        float value;
+        std::memcpy(&value, pointData(i) + offset, sizeof(float));
+        return value;
+    }
+};
+
+#endif // LINE_EXTRACTOR_IGVC_POINTCLOUDVIEW_H
@@ -0,0 +1,103 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class declaration for RansacRegression, which calculates a
+ *              line of best fit for each cluster of points while ignoring
+ *              outliers (MSAC)
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_RANSACREGRESSION_H
+#define LINE_EXTRACTOR_IGVC_RANSACREGRESSION_H
+
+#include "Regression.h"
+#include <Eigen/Dense>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <random>
+
+class RansacRegression {
+    /*
+     * A point is an inlier to a line if its vertical distance to the line
+     * is at most @_inlier_threshold
+     */
+    float _inlier_threshold = 0.05;
+
+    /*
+     * Probability that at least one sample drawn is free of outliers,
+     * used to decide how many iterations are needed
+     */
+    float _confidence = 0.99;
+
+    /*
+     * Hard cap on the number of samples drawn per cluster
+     */
+    unsigned int _max_iterations = 200;
+
+    /*
+     * Maximum time in milliseconds spent sampling a single cluster. Once the
+     * budget is used up the best line found so far is refined and returned.
+     */
+    float _time_budget_ms = 5;
+
+    /*
+     * Seed of the random number generator. Cluster i is sampled with
+     * @_seed + i, so the output is reproducible even when clusters are
+     * processed in parallel.
+     */
+    unsigned int _seed = 123;
+
+    unsigned int _sequential_cut_off = 1000;
+
+  public:
+    /*
+     * Constructor:
+     * Takes in the inlier threshold, confidence, maximum number of iterations,
+     * time budget per cluster (ms) and random seed as parameters
+     */
+    RansacRegression(float inlier_threshold      = 0.05,
+                     float confidence            = 0.99,
+                     unsigned int max_iterations = 200,
+                     float time_budget_ms        = 5,
+                     unsigned int seed           = 123);
+
+    /*
+     * Returns a std::vector of Eigen::VectorXf
+     * Each Eigen::VectorXf corresponds to the line of best fit of the inliers
+     * of a PointCloud<PointXYZ> cluster
+     * The corresponding vector and cluster have the same index within each of
+     * their vectors.
+     * @poly_degree: Degree of polynomial of the line of best fit
+     * @lambda: Regularization parameter of the final least squares fit
+     * (Default: 0)
+     */
+    std::vector<Eigen::VectorXf> getLinesOfBestFit(
+    const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
+    unsigned int poly_degree,
+    float lambda = 0) const;
+
+    /*
+     * Returns a line of best fit given a cluster, sampling it with a
+     * generator seeded with @seed
+     */
+    Eigen::VectorXf
+    getLineOfCluster(const pcl::PointCloud<pcl::PointXYZ>& cluster,
+                     unsigned int poly_degree,
+                     float lambda,
+                     unsigned int seed) const;
+
+  private:
+    /*
+     * Number of samples needed to draw at least one outlier-free sample
+     * with probability @_confidence, given the fraction of inliers and the
+     * number of points in a sample
+     */
+    unsigned int requiredIterations(double inlier_ratio,
+                                    unsigned int sample_size) const;
+
+    /*
+     * Evaluates the polynomial with the given coefficients at @x
+     */
+    static double evaluate(const Eigen::VectorXd& coefficients, double x);
+};
+
+#endif // LINE_EXTRACTOR_IGVC_RANSACREGRESSION_H
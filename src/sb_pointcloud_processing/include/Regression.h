@@ -24,28 +24,48 @@ class Regression {
      * PointCloud<PointXYZ> cluster
      * The corresponding vector and cluster have the same index within each of
      * their vectors.
+     * Clusters are fitted in parallel if there are enough points in total.
      * @poly_degree: Degree of polynomial of the line of best fit
      * @lambda: Regularization parameter (Default: 0)
      */
-    static std::vector<Eigen::VectorXf>
-    getLinesOfBestFit(std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters,
-                      unsigned int poly_degree,
-                      float lambda = 0);
+    static std::vector<Eigen::VectorXf> getLinesOfBestFit(
+    const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
+    unsigned int poly_degree,
+    float lambda = 0);
 
-  private:
     /*
      * Returns a line of best fit given a cluster
      */
     static Eigen::VectorXf
-    getLineOfCluster(pcl::PointCloud<pcl::PointXYZ> cluster,
+    getLineOfCluster(const pcl::PointCloud<pcl::PointXYZ>& cluster,
                      unsigned int poly_degree,
                      float lambda = 0);
 
+  private:
+    /*
+     * If the total number of points across all clusters is at most this,
+     * clusters are fitted sequentially, since the overhead of spawning threads
+     * would outweigh the time gained.
+     */
+    static const unsigned int _sequential_cut_off = 1000;
+
     /*
-     * Constructs a row in the matrix X given a data point and degree of
-     * polynomial
+     * Line of best fit for a polynomial degree known at compile time.
+     * All matrices are fixed size, so nothing is allocated on the heap.
      */
-    static Eigen::VectorXf constructRow(float x, unsigned int poly_degree);
+    template <int Degree>
+    static Eigen::VectorXf
+    getLineOfClusterFixed(const pcl::PointCloud<pcl::PointXYZ>& cluster,
+                          float lambda);
+
+    /*
+     * Line of best fit for any polynomial degree, used when there is no
+     * fixed size specialisation for @poly_degree
+     */
+    static Eigen::VectorXf
+    getLineOfClusterDynamic(const pcl::PointCloud<pcl::PointXYZ>& cluster,
+                            unsigned int poly_degree,
+                            float lambda);
 };
 
 #endif // PROJECT_REGRESSION_H
@@ -0,0 +1,162 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class declaration for SyntheticCloudGenerator, which builds
+ *              pointclouds of noisy polynomial lines, cone shaped blobs and
+ *              gaussian clutter, of up to millions of points, for driving the
+ *              pointcloud pipeline under load
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_SYNTHETICCLOUDGENERATOR_H
+#define LINE_EXTRACTOR_IGVC_SYNTHETICCLOUDGENERATOR_H
+
+#include <cstdint>
+#include <sensor_msgs/PointCloud2.h>
+#include <vector>
+
+class SyntheticCloudGenerator {
+  public:
+    /*
+     * A polynomial y = sum(coefficients[i] * x^i) over [x_min, x_max], sampled
+     * at @num_points evenly spaced x, each moved by up to @noise_x and
+     * @noise_y (uniformly)
+     */
+    struct Line {
+        std::vector<float> coefficients;
+        float x_min;
+        float x_max;
+        unsigned int num_points;
+        float noise_x;
+        float noise_y;
+    };
+
+    /*
+     * @num_points scattered over the surface of an upright cone standing on
+     * the ground at (x, y)
+     */
+    struct Cone {
+        float x;
+        float y;
+        float radius;
+        float height;
+        unsigned int num_points;
+    };
+
+    /*
+     * @num_points normally distributed around (x, y, 0), with standard
+     * deviation @stddev in x and y and @stddev_z in z
+     */
+    struct Clutter {
+        float x;
+        float y;
+        float stddev;
+        float stddev_z;
+        unsigned int num_points;
+    };
+
+    // colours the points are given, so they survive the colour filters
+    static const uint32_t LINE_RGB    = 0xffffff;
+    static const uint32_t CONE_RGB    = 0xff6600;
+    static const uint32_t CLUTTER_RGB = 0x2e8b2e;
+
+    /*
+     * Constructor:
+     * The same @seed generates the same sequence of clouds
+     */
+    explicit SyntheticCloudGenerator(unsigned int seed = 123);
+
+    void addLine(const Line& line);
+    void addCone(const Cone& cone);
+    void addClutter(const Clutter& clutter);
+
+    /*
+     * Adds @num_lines lines of degree @degree with random coefficients, whose
+     * y stays roughly within [-y_range, y_range] over [x_min, x_max]
+     */
+    void addRandomLines(unsigned int num_lines,
+                        unsigned int degree,
+                        float x_min,
+                        float x_max,
+                        float y_range,
+                        unsigned int points_per_line,
+                        float noise);
+
+    /*
+     * Adds @num_cones cones at random positions within [x_min, x_max] and
+     * [-y_range, y_range]
+     */
+    void addRandomCones(unsigned int num_cones,
+                        float x_min,
+                        float x_max,
+                        float y_range,
+                        float radius,
+                        float height,
+                        unsigned int points_per_cone);
+
+    /*
+     * Lays out the points @width to a row, padding the last row with NaN
+     * points, as a depth camera would. 0 (the default) publishes an
+     * unorganised cloud.
+     */
+    void setOrganisedWidth(unsigned int width) { _organised_width = width; }
+
+    /*
+     * Total number of points of all the lines, cones and clutter
+     */
+    size_t numPoints() const;
+
+    /*
+     * Fills @cloud with the next frame, with float32 x, y, z and rgb fields.
+     * The noise is different each frame. @cloud's buffer is reused if it is
+     * already the right size.
+     */
+    void generate(sensor_msgs::PointCloud2& cloud);
+
+    /*
+     * Restarts the sequence of frames
+     */
+    void reset() { _frame = 0; }
+
+  private:
+    /*
+     * A run of points that all come from one line, cone or clutter, and are
+     * generated with their own random number generator so runs can be
+     * generated in parallel and still give the same points
+     */
+    struct Run {
+        enum Type { LINE, CONE, CLUTTER } type;
+        unsigned int element;
+        size_t first_point;
+        size_t first_output;
+        size_t num_points;
+    };
+
+    unsigned int _seed;
+    uint64_t _frame = 0;
+
+    unsigned int _organised_width = 0;
+
+    std::vector<Line> _lines;
+    std::vector<Cone> _cones;
+    std::vector<Clutter> _clutter;
+
+    std::vector<Run> _runs;
+    size_t _num_points = 0;
+
+    // generator for the random lines and cones, separate from the per frame
+    // noise
+    uint64_t _layout_state;
+
+    /*
+     * Points per run, small enough to spread large clouds across threads
+     */
+    static const size_t RUN_SIZE = 16384;
+
+    void addRuns(Run::Type type, unsigned int element, size_t num_points);
+
+    float layoutUniform(float min, float max);
+
+    void generateRun(const Run& run, uint8_t* data) const;
+};
+
+#endif // LINE_EXTRACTOR_IGVC_SYNTHETICCLOUDGENERATOR_H
@@ -0,0 +1,97 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class declaration for VoxelGridDownsampler, which bins a
+ *              PointCloud into a 2D or 3D grid in a single pass and keeps one
+ *              centroid per occupied cell, up to a maximum number of points
+ */
+
+#ifndef LINE_EXTRACTOR_IGVC_VOXELGRIDDOWNSAMPLER_H
+#define LINE_EXTRACTOR_IGVC_VOXELGRIDDOWNSAMPLER_H
+
+#include "PointCloudView.h"
+#include <cstdint>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <unordered_map>
+#include <vector>
+
+class VoxelGridDownsampler {
+    /*
+     * Running sum of the points that fell into a cell
+     */
+    struct Cell {
+        double x;
+        double y;
+        double z;
+        unsigned int count;
+    };
+
+    /*
+     * Side length of a cell. If 0, points are passed through (only the
+     * point budget is enforced)
+     */
+    float _leaf_size;
+
+    /*
+     * If false, the grid is 2D: points are binned by x and y only, so all
+     * points in a column end up in the same cell
+     */
+    bool _use_z;
+
+    /*
+     * Maximum number of points output. 0 means no limit
+     */
+    unsigned int _max_points;
+
+    /*
+     * Occupied cells, in the order they were first hit. Kept between calls
+     * so their memory is reused
+     */
+    std::vector<Cell> _cells;
+
+    /*
+     * Key: packed cell coordinates
+     * Value: index of the cell in @_cells
+     */
+    std::unordered_map<uint64_t, unsigned int> _cell_index;
+
+  public:
+    /*
+     * Constructor:
+     * Takes in the cell size, whether to bin by z, and the point budget
+     */
+    VoxelGridDownsampler(float leaf_size         = 0.05,
+                         bool use_z              = true,
+                         unsigned int max_points = 0);
+
+    /*
+     * Main entry function:
+     * Fills @output with the centroid of each occupied cell of @input.
+     * If there are more than @_max_points occupied cells, an evenly spaced
+     * subset of them (in the order of @input) is kept.
+     * Non-finite points are skipped.
+     */
+    void downsample(const PointCloudView& input,
+                    pcl::PointCloud<pcl::PointXYZ>& output);
+
+    void setLeafSize(float leaf_size);
+    void setUseZ(bool use_z);
+    void setMaxPoints(unsigned int max_points);
+
+  private:
+    /*
+     * Packs the cell coordinates of a point into a single key, 21 bits per
+     * axis. Cells more than 2^20 leaves from the origin wrap around.
+     */
+    uint64_t cellKey(float x, float y, float z) const;
+
+    /*
+     * Copies the centroids of @count of @cells, evenly spaced, into @output
+     */
+    void takeEvenlySpaced(const std::vector<Cell>& cells,
+                          unsigned int count,
+                          pcl::PointCloud<pcl::PointXYZ>& output) const;
+};
+
+#endif // LINE_EXTRACTOR_IGVC_VOXELGRIDDOWNSAMPLER_H
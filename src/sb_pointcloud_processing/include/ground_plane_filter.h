@@ -0,0 +1,100 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which estimates the ground plane of a pointcloud
+ *              and keeps only the points within a band around it. Replaces
+ *              the fixed height PassThrough filter, which breaks on slopes
+ *              and while the chassis pitches.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_GROUND_PLANE_FILTER_H
+#define SB_POINTCLOUD_PROCESSING_GROUND_PLANE_FILTER_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <GroundPlaneSegmenter.h>
+#include <sb_utils.h>
+
+namespace sb_pointcloud_processing {
+
+class GroundPlaneFilter : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    GroundPlaneFilter();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    /**
+     * Callback which segments a given pointcloud, estimating the plane from
+     * it too unless it is estimated from a separate cloud
+     *
+     * @param input the pointcloud to be filtered
+     */
+    void callback(const sensor_msgs::PointCloud2::ConstPtr& input);
+
+    /**
+     * Callback which estimates the plane from a given pointcloud, when it is
+     * estimated from a separate cloud to the one filtered
+     *
+     * @param input the pointcloud to estimate the plane from
+     */
+    void planeCallback(const sensor_msgs::PointCloud2::ConstPtr& input);
+
+    /**
+     * Looks up the transform from the frame of the given cloud to
+     * output_frame. tf may wait for it, so this is done without holding
+     * mutex.
+     *
+     * @param transform set to the transform, if one is needed
+     * @param transformed set to false if the cloud is already in
+     * output_frame
+     * @return false if the transform could not be looked up
+     */
+    bool lookupTransform(const std_msgs::Header& header,
+                         Eigen::Affine3f& transform,
+                         bool& transformed);
+
+    // Holds the plane of the previous cloud, which the next one is
+    // warm started from. Guarded by mutex, as the plane and the filtered
+    // clouds can come in on different threads.
+    boost::shared_ptr<GroundPlaneSegmenter> segmenter;
+    boost::mutex mutex;
+
+    // Whether the plane is estimated from the clouds on ~plane_input, such as
+    // the whole unfiltered cloud, and applied to the clouds on ~input
+    bool separate_plane_input;
+
+    // Frame to transform the points into before estimating the plane,
+    // empty to use the input frame. Its z axis should point up.
+    std::string output_frame;
+
+    tf2_ros::Buffer tf_buffer;
+    boost::shared_ptr<tf2_ros::TransformListener> tf_listener;
+
+    // Publishes the filtered pointcloud
+    ros::Publisher pub;
+
+    // The last message published, refilled once subscribers let go of it
+    sensor_msgs::PointCloud2::Ptr output;
+
+    // Subscribes to the pointcloud, and to the one the plane is estimated
+    // from
+    ros::Subscriber sub;
+    ros::Subscriber plane_sub;
+};
+}
+
+#endif // SB_POINTCLOUD_PROCESSING_GROUND_PLANE_FILTER_H
@@ -0,0 +1,80 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which takes a pointcloud in the RGB colourspace
+ *              and keeps only the points within hue, saturation, value and
+ *              height limits. Replaces the rgb_to_hsv -> h -> s -> v -> z
+ *              nodelet chain with a single pass over the cloud.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_HSV_HEIGHT_FILTER_H
+#define SB_POINTCLOUD_PROCESSING_HSV_HEIGHT_FILTER_H
+
+// ROS Includes
+#include <dynamic_reconfigure/server.h>
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <ColourHeightFilter.h>
+#include <sb_pointcloud_processing/HSVHeightFilterConfig.h>
+
+namespace sb_pointcloud_processing {
+
+class HSVHeightFilter : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    HSVHeightFilter();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    /**
+     * Callback which filters a given RGB pointcloud
+     *
+     * @param input the RGB pointcloud to be filtered
+     */
+    void callback(const sensor_msgs::PointCloud2::ConstPtr& input);
+
+    /**
+     * Callback which updates the filter limits on a dynamic reconfigure
+     * request
+     */
+    void reconfigureCallback(HSVHeightFilterConfig& config, uint32_t level);
+
+    // Filters the pointcloud, guarded by mutex as reconfigure callbacks
+    // come in on a different thread
+    ColourHeightFilter filter;
+    boost::mutex mutex;
+
+    // Frame to transform the points into before checking their height,
+    // empty to use the input frame
+    std::string output_frame;
+
+    tf2_ros::Buffer tf_buffer;
+    boost::shared_ptr<tf2_ros::TransformListener> tf_listener;
+
+    boost::shared_ptr<dynamic_reconfigure::Server<HSVHeightFilterConfig>>
+    reconfigure_server;
+
+    // Publishes the filtered pointcloud
+    ros::Publisher pub;
+
+    // The last message published, refilled once subscribers let go of it
+    sensor_msgs::PointCloud2::Ptr output;
+
+    // Subscribes to the RGB pointcloud
+    ros::Subscriber sub;
+};
+}
+
+#endif // SB_POINTCLOUD_PROCESSING_HSV_HEIGHT_FILTER_H
@@ -0,0 +1,38 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which extracts line obstacles from a pointcloud.
+ *              Runs LineExtractorNode inside a nodelet manager, so filtered
+ *              clouds from the filter nodelets arrive without serialisation.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_LINE_EXTRACTOR_NODELET_H
+#define SB_POINTCLOUD_PROCESSING_LINE_EXTRACTOR_NODELET_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+
+#include <LineExtractorNode.h>
+
+namespace sb_pointcloud_processing {
+
+class LineExtractorNodelet : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    LineExtractorNodelet();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    // Does all the work, set up with the nodelet's node handles
+    boost::shared_ptr<LineExtractorNode> line_extractor;
+};
+}
+
+#endif // SB_POINTCLOUD_PROCESSING_LINE_EXTRACTOR_NODELET_H
@@ -0,0 +1,78 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which projects a filtered pointcloud onto an
+ *              occupancy grid centred on the robot, for PathFinderNode.
+ */
+
+#ifndef SB_POINTCLOUD_PROCESSING_POINTCLOUD_TO_OCCUPANCY_GRID_H
+#define SB_POINTCLOUD_PROCESSING_POINTCLOUD_TO_OCCUPANCY_GRID_H
+
+// ROS Includes
+#include <nav_msgs/OccupancyGrid.h>
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <OccupancyGridProjector.h>
+#include <sb_utils.h>
+
+namespace sb_pointcloud_processing {
+
+class PointCloudToOccupancyGrid : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    PointCloudToOccupancyGrid();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    /**
+     * Callback which projects a given pointcloud onto the grid and
+     * publishes it
+     *
+     * @param input the pointcloud of obstacles
+     */
+    void callback(const sensor_msgs::PointCloud2::ConstPtr& input);
+
+    /**
+     * Looks up the transform taking points from @source_frame to
+     * @grid_frame at @stamp
+     *
+     * @return false if the transform isn't available
+     */
+    bool lookupTransform(const std::string& source_frame,
+                         const ros::Time& stamp,
+                         Eigen::Affine3f& transform);
+
+    OccupancyGridProjector projector;
+
+    // Frame the grid is axis aligned in, which PathFinderNode plans in
+    std::string grid_frame;
+
+    // The grid is centred on the origin of this frame
+    std::string base_frame;
+
+    // Filled in place on every pointcloud, unless a subscriber still holds
+    // the last one
+    nav_msgs::OccupancyGrid::Ptr grid;
+
+    tf2_ros::Buffer tf_buffer;
+    boost::shared_ptr<tf2_ros::TransformListener> tf_listener;
+
+    // Publishes the occupancy grid
+    ros::Publisher pub;
+
+    // Subscribes to the pointcloud of obstacles
+    ros::Subscriber sub;
+};
+}
+
+#endif // SB_POINTCLOUD_PROCESSING_POINTCLOUD_TO_OCCUPANCY_GRID_H
@@ -0,0 +1,92 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: Sets dynamic_reconfigure parameters of other nodes from a
+ *              background thread.
+ */
+
+#include "AsyncReconfigureClient.h"
+#include <dynamic_reconfigure/Reconfigure.h>
+
+AsyncReconfigureClient::AsyncReconfigureClient(
+ros::WallDuration service_timeout)
+  : service_timeout(service_timeout), sending(false), stopped(false) {
+    worker = std::thread(&AsyncReconfigureClient::run, this);
+}
+
+AsyncReconfigureClient::~AsyncReconfigureClient() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        pending.clear();
+    }
+    condition.notify_all();
+    worker.join();
+}
+
+void AsyncReconfigureClient::setParameters(
+const std::string& node_name, const std::map<std::string, double>& params) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, double>& node_params = pending[node_name];
+        for (const auto& param : params) {
+            node_params[param.first] = param.second;
+        }
+    }
+    condition.notify_one();
+}
+
+bool AsyncReconfigureClient::isBusy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sending || !pending.empty();
+}
+
+void AsyncReconfigureClient::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        condition.wait(lock, [this] { return stopped || !pending.empty(); });
+        if (stopped) return;
+
+        // Take everything queued so far, newer updates queue up behind it
+        std::map<std::string, std::map<std::string, double>> updates;
+        updates.swap(pending);
+        sending = true;
+        lock.unlock();
+
+        for (const auto& update : updates) {
+            if (send(update.first, update.second)) {
+                ROS_INFO_STREAM("Updated parameters of " << update.first);
+            }
+        }
+
+        lock.lock();
+        sending = false;
+    }
+}
+
+bool AsyncReconfigureClient::send(const std::string& node_name,
+                                  const std::map<std::string, double>& params) {
+    std::string service_name = node_name + "/set_parameters";
+    if (!ros::service::waitForService(service_name,
+                                      ros::Duration(service_timeout.toSec()))) {
+        ROS_WARN_STREAM("Could not reconfigure " << node_name << ", "
+                                                 << service_name
+                                                 << " is not available");
+        return false;
+    }
+
+    dynamic_reconfigure::Reconfigure reconfigure;
+    for (const auto& param : params) {
+        dynamic_reconfigure::DoubleParameter double_param;
+        double_param.name  = param.first;
+        double_param.value = param.second;
+        reconfigure.request.config.doubles.push_back(double_param);
+    }
+
+    if (!ros::service::call(service_name, reconfigure)) {
+        ROS_WARN_STREAM("Could not reconfigure " << node_name);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,256 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class implementation for CloudRecordingWriter and
+ *              CloudRecording
+ */
+
+#include "CloudRecording.h"
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace cloud_recording;
+
+CloudRecordingWriter::~CloudRecordingWriter() {
+    close();
+}
+
+bool CloudRecordingWriter::open(const std::string& path) {
+    close();
+
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) { return false; }
+
+    // frames are written in large blocks anyway, and without a buffer a
+    // failed write leaves nothing behind to be flushed after truncating
+    std::setvbuf(_file, nullptr, _IONBF, 0);
+
+    _index.clear();
+    _offset = 0;
+    _failed = false;
+
+    // the header is rewritten with the frame count and index offset on close
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+
+    if (!write(&header, sizeof(header)) || !pad()) {
+        std::fclose(_file);
+        _file = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool CloudRecordingWriter::append(const sensor_msgs::PointCloud2& cloud) {
+    if (!_file || _failed) { return false; }
+
+    PointCloudView view(cloud);
+    if (view.empty() && cloud.width * cloud.height > 0) { return false; }
+
+    int rgb_offset = -1;
+    for (const sensor_msgs::PointField& field : cloud.fields) {
+        if ((field.name == "rgb" || field.name == "rgba") &&
+            (field.datatype == sensor_msgs::PointField::FLOAT32 ||
+             field.datatype == sensor_msgs::PointField::UINT32)) {
+            rgb_offset = field.offset;
+        }
+    }
+    // the view has checked that every point lies within the data, so only
+    // the rgb field itself is left to check
+    if (rgb_offset >= 0 &&
+        (uint64_t) rgb_offset + sizeof(uint32_t) > cloud.point_step) {
+        rgb_offset = -1;
+    }
+
+    _xyz.clear();
+    _rgb.clear();
+    _xyz.reserve(view.size() * 3);
+    if (rgb_offset >= 0) { _rgb.reserve(view.size()); }
+
+    for (size_t i = 0; i < view.size(); i++) {
+        float x = view.x(i), y = view.y(i), z = view.z(i);
+        if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+            continue;
+        }
+
+        _xyz.push_back(x);
+        _xyz.push_back(y);
+        _xyz.push_back(z);
+
+        if (rgb_offset >= 0) {
+            size_t row = i / cloud.width, column = i % cloud.width;
+            uint32_t rgb;
+            std::memcpy(&rgb,
+                        cloud.data.data() + row * cloud.row_step +
+                        column * cloud.point_step + rgb_offset,
+                        sizeof(rgb));
+            _rgb.push_back(rgb);
+        }
+    }
+
+    FrameIndexEntry entry = {};
+    entry.stamp           = cloud.header.stamp.toSec();
+    entry.seq             = cloud.header.seq;
+    entry.num_points      = _xyz.size() / 3;
+
+    entry.xyz_offset = _offset;
+    if (!write(_xyz.data(), _xyz.size() * sizeof(float)) || !pad()) {
+        truncate(entry.xyz_offset);
+        return false;
+    }
+
+    if (rgb_offset >= 0) {
+        entry.rgb_offset = _offset;
+        if (!write(_rgb.data(), _rgb.size() * sizeof(uint32_t)) || !pad()) {
+            truncate(entry.xyz_offset);
+            return false;
+        }
+    }
+
+    _index.push_back(entry);
+
+    return true;
+}
+
+bool CloudRecordingWriter::close() {
+    if (!_file) { return true; }
+
+    // the file can't be trusted to match the index any more
+    if (_failed) {
+        std::fclose(_file);
+        _file = nullptr;
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version      = VERSION;
+    header.num_frames   = _index.size();
+    header.index_offset = _offset;
+
+    bool success =
+    write(_index.data(), _index.size() * sizeof(FrameIndexEntry)) &&
+    std::fseek(_file, 0, SEEK_SET) == 0 && write(&header, sizeof(header));
+
+    success = std::fclose(_file) == 0 && success;
+    _file   = nullptr;
+
+    return success;
+}
+
+bool CloudRecordingWriter::write(const void* data, size_t size) {
+    if (size == 0) { return true; }
+    if (std::fwrite(data, 1, size, _file) != size) { return false; }
+    _offset += size;
+    return true;
+}
+
+bool CloudRecordingWriter::truncate(uint64_t offset) {
+    std::clearerr(_file);
+    if (ftruncate(fileno(_file), offset) != 0 ||
+        std::fseek(_file, offset, SEEK_SET) != 0) {
+        _failed = true;
+        return false;
+    }
+    _offset = offset;
+    return true;
+}
+
+bool CloudRecordingWriter::pad() {
+    static const uint8_t zeros[BLOCK_ALIGNMENT] = {};
+    return write(
+    zeros, (BLOCK_ALIGNMENT - _offset % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT);
+}
+
+CloudRecording::~CloudRecording() {
+    close();
+}
+
+bool CloudRecording::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 ||
+        (size_t) file_stat.st_size < sizeof(FileHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* data =
+    mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the file is closed
+    ::close(fd);
+    if (data == MAP_FAILED) { return false; }
+
+    _data = static_cast<const uint8_t*>(data);
+    _size = file_stat.st_size;
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(_data);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header->version == VERSION &&
+                 header->index_offset % alignof(FrameIndexEntry) == 0 &&
+                 header->index_offset <= _size &&
+                 (_size - header->index_offset) / sizeof(FrameIndexEntry) >=
+                 header->num_frames;
+
+    if (valid) {
+        _index =
+        reinterpret_cast<const FrameIndexEntry*>(_data + header->index_offset);
+        _num_frames = header->num_frames;
+    }
+
+    // make sure every frame lies inside the file, so frame() doesn't need to
+    for (uint32_t i = 0; valid && i < _num_frames; i++) {
+        const FrameIndexEntry& entry = _index[i];
+        uint64_t xyz_size = (uint64_t) entry.num_points * 3 * sizeof(float);
+        uint64_t rgb_size = (uint64_t) entry.num_points * sizeof(uint32_t);
+
+        valid = entry.xyz_offset % BLOCK_ALIGNMENT == 0 &&
+                entry.xyz_offset + xyz_size <= header->index_offset &&
+                entry.rgb_offset % BLOCK_ALIGNMENT == 0 &&
+                entry.rgb_offset + rgb_size <= header->index_offset;
+    }
+
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    // frames are read front to back
+    madvise(const_cast<uint8_t*>(_data), _size, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+void CloudRecording::close() {
+    if (_data) { munmap(const_cast<uint8_t*>(_data), _size); }
+
+    _data       = nullptr;
+    _size       = 0;
+    _index      = nullptr;
+    _num_frames = 0;
+}
+
+CloudRecording::Frame CloudRecording::frame(size_t i) const {
+    const FrameIndexEntry& entry = _index[i];
+
+    Frame frame;
+    frame.stamp      = entry.stamp;
+    frame.seq        = entry.seq;
+    frame.num_points = entry.num_points;
+    frame.xyz        = reinterpret_cast<const float*>(_data + entry.xyz_offset);
+    frame.rgb        = entry.rgb_offset == 0
+                ? nullptr
+                : reinterpret_cast<const uint32_t*>(_data + entry.rgb_offset);
+
+    return frame;
+}
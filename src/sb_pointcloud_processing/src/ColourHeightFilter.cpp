@@ -0,0 +1,150 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A class which filters an RGB pointcloud by hue, saturation,
+ *              value and height in a single pass.
+ */
+
+#include <ColourHeightFilter.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Output points are laid out like pcl::PointXYZ: x, y, z and one float padding
+static const uint32_t OUTPUT_POINT_STEP = 4 * sizeof(float);
+
+ColourHeightFilter::ColourHeightFilter()
+  : h_min_(0),
+    h_max_(360),
+    s_min_(0),
+    s_max_(1),
+    v_min_(0),
+    v_max_(1),
+    z_min_(-std::numeric_limits<float>::max()),
+    z_max_(std::numeric_limits<float>::max()),
+    has_transform_(false),
+    transform_(Eigen::Affine3f::Identity()) {}
+
+void ColourHeightFilter::setHueLimits(float min, float max) {
+    h_min_ = min;
+    h_max_ = max;
+}
+
+void ColourHeightFilter::setSaturationLimits(float min, float max) {
+    s_min_ = min;
+    s_max_ = max;
+}
+
+void ColourHeightFilter::setValueLimits(float min, float max) {
+    v_min_ = min;
+    v_max_ = max;
+}
+
+void ColourHeightFilter::setHeightLimits(float min, float max) {
+    z_min_ = min;
+    z_max_ = max;
+}
+
+void ColourHeightFilter::setTransform(const Eigen::Affine3f& transform) {
+    transform_     = transform;
+    has_transform_ = true;
+}
+
+void ColourHeightFilter::clearTransform() {
+    transform_     = Eigen::Affine3f::Identity();
+    has_transform_ = false;
+}
+
+bool ColourHeightFilter::filter(const sensor_msgs::PointCloud2& input,
+                                sensor_msgs::PointCloud2& output) const {
+    // Find where each field we need lives within a point
+    int x_offset = -1, y_offset = -1, z_offset = -1, rgb_offset = -1;
+    for (const sensor_msgs::PointField& field : input.fields) {
+        bool is_float = field.datatype == sensor_msgs::PointField::FLOAT32;
+        if (field.name == "x" && is_float) x_offset = field.offset;
+        if (field.name == "y" && is_float) y_offset = field.offset;
+        if (field.name == "z" && is_float) z_offset = field.offset;
+        if (field.name == "rgb" || field.name == "rgba")
+            rgb_offset = field.offset;
+    }
+    if (x_offset < 0 || y_offset < 0 || z_offset < 0 || rgb_offset < 0) {
+        return false;
+    }
+
+    // Make sure every point and field we read lies within the data, so a
+    // malformed or truncated cloud is rejected instead of read past its end
+    uint64_t field_end =
+    std::max(std::max(x_offset, y_offset), std::max(z_offset, rgb_offset)) +
+    sizeof(float);
+    if ((uint64_t) input.height * input.row_step > input.data.size() ||
+        (uint64_t) input.width * input.point_step > input.row_step ||
+        field_end > input.point_step) {
+        return false;
+    }
+
+    output.header       = input.header;
+    output.height       = 1;
+    output.is_bigendian = false;
+    output.is_dense     = true;
+    output.point_step   = OUTPUT_POINT_STEP;
+    output.fields.resize(3);
+    const char* names[] = {"x", "y", "z"};
+    for (unsigned int i = 0; i < 3; i++) {
+        output.fields[i].name     = names[i];
+        output.fields[i].offset   = i * sizeof(float);
+        output.fields[i].datatype = sensor_msgs::PointField::FLOAT32;
+        output.fields[i].count    = 1;
+    }
+
+    // Allocate for the worst case (every point survives) once, then shrink
+    output.data.resize((size_t) input.width * input.height * OUTPUT_POINT_STEP);
+    uint8_t* out_ptr = output.data.data();
+
+    uint32_t num_kept = 0;
+    for (uint32_t row = 0; row < input.height; row++) {
+        const uint8_t* point_ptr = &input.data[row * input.row_step];
+        for (uint32_t col = 0; col < input.width;
+             col++, point_ptr += input.point_step) {
+            Eigen::Vector3f p;
+            std::memcpy(&p.x(), point_ptr + x_offset, sizeof(float));
+            std::memcpy(&p.y(), point_ptr + y_offset, sizeof(float));
+            std::memcpy(&p.z(), point_ptr + z_offset, sizeof(float));
+
+            if (!std::isfinite(p.x()) || !std::isfinite(p.y()) ||
+                !std::isfinite(p.z())) {
+                continue;
+            }
+
+            if (has_transform_) p = transform_ * p;
+
+            // Check height first as it is the cheapest test
+            if (p.z() < z_min_ || p.z() > z_max_) continue;
+
+            uint32_t rgb;
+            std::memcpy(&rgb, point_ptr + rgb_offset, sizeof(uint32_t));
+            unsigned char r = (rgb >> 16) & 0xff;
+            unsigned char g = (rgb >> 8) & 0xff;
+            unsigned char b = rgb & 0xff;
+
+            float h, s, v;
+            ColourspaceConverter::rgbToHsv(r, g, b, h, s, v);
+
+            if (h < h_min_ || h > h_max_ || s < s_min_ || s > s_max_ ||
+                v < v_min_ || v > v_max_) {
+                continue;
+            }
+
+            float xyz[4] = {p.x(), p.y(), p.z(), 0};
+            std::memcpy(out_ptr, xyz, OUTPUT_POINT_STEP);
+            out_ptr += OUTPUT_POINT_STEP;
+            num_kept++;
+        }
+    }
+
+    output.width    = num_kept;
+    output.row_step = num_kept * OUTPUT_POINT_STEP;
+    output.data.resize(output.row_step);
+
+    return true;
+}
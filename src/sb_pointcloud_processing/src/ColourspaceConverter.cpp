@@ -6,8 +6,183 @@
 
 #include <ColourspaceConverter.h>
 
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
 using namespace pcl;
 
+#ifdef __SSE2__
+/*
+ * Batch conversion kernels. Each converts @num_points points, which must be a
+ * multiple of 8, from @in into @out.
+ *
+ * Hue is computed without branching: the sector offset (0, 2 or 4) and the
+ * numerator are selected with masks depending on which channel is the max.
+ * Divisions are replaced by a reciprocal estimate refined with one
+ * Newton-Raphson step, which is accurate to about 1 ulp.
+ */
+
+// Converts 4 points with SSE2
+static inline void
+convert4SSE2(const PointXYZRGB* in, float* h, float* s, float* v) {
+    const __m128i rgba =
+    _mm_set_epi32(in[3].rgba, in[2].rgba, in[1].rgba, in[0].rgba);
+    const __m128i byte_mask = _mm_set1_epi32(0xff);
+    const __m128 r =
+    _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(rgba, 16), byte_mask));
+    const __m128 g =
+    _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(rgba, 8), byte_mask));
+    const __m128 b = _mm_cvtepi32_ps(_mm_and_si128(rgba, byte_mask));
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max  = _mm_max_ps(r, _mm_max_ps(g, b));
+    const __m128 min  = _mm_min_ps(r, _mm_min_ps(g, b));
+    const __m128 diff = _mm_sub_ps(max, min);
+
+    // 1 / x with one Newton-Raphson step: y * (2 - x * y)
+    const __m128 two      = _mm_set1_ps(2.f);
+    __m128 max_reciprocal = _mm_rcp_ps(max);
+    max_reciprocal        = _mm_mul_ps(
+    max_reciprocal, _mm_sub_ps(two, _mm_mul_ps(max, max_reciprocal)));
+    __m128 diff_reciprocal = _mm_rcp_ps(diff);
+    diff_reciprocal        = _mm_mul_ps(
+    diff_reciprocal, _mm_sub_ps(two, _mm_mul_ps(diff, diff_reciprocal)));
+
+    const __m128 v_out = _mm_mul_ps(max, _mm_set1_ps(1.f / 255.f));
+
+    // s = diff / max, or 0 if max is 0
+    const __m128 max_is_zero = _mm_cmpeq_ps(max, zero);
+    const __m128 s_out =
+    _mm_andnot_ps(max_is_zero, _mm_mul_ps(diff, max_reciprocal));
+
+    // Pick the hue sector based on which channel is the max
+    const __m128 max_is_r = _mm_cmpeq_ps(max, r);
+    const __m128 max_is_g = _mm_andnot_ps(max_is_r, _mm_cmpeq_ps(max, g));
+    const __m128 max_is_b = _mm_andnot_ps(_mm_or_ps(max_is_r, max_is_g),
+                                          _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+    const __m128 numerator =
+    _mm_or_ps(_mm_and_ps(max_is_r, _mm_sub_ps(g, b)),
+              _mm_or_ps(_mm_and_ps(max_is_g, _mm_sub_ps(b, r)),
+                        _mm_and_ps(max_is_b, _mm_sub_ps(r, g))));
+    const __m128 offset = _mm_or_ps(_mm_and_ps(max_is_g, two),
+                                    _mm_and_ps(max_is_b, _mm_set1_ps(4.f)));
+
+    __m128 h_out =
+    _mm_mul_ps(_mm_set1_ps(60.f),
+               _mm_add_ps(offset, _mm_mul_ps(numerator, diff_reciprocal)));
+
+    // Wrap negative hues around, and set hue to 0 for greys (diff == 0)
+    h_out = _mm_add_ps(
+    h_out, _mm_and_ps(_mm_cmplt_ps(h_out, zero), _mm_set1_ps(360.f)));
+    h_out = _mm_andnot_ps(_mm_cmpeq_ps(diff, zero), h_out);
+
+    _mm_storeu_ps(h, h_out);
+    _mm_storeu_ps(s, s_out);
+    _mm_storeu_ps(v, v_out);
+}
+
+// Copies the position and the 8 converted colours of a batch into @out
+static inline void writeBatch(const PointXYZRGB* in,
+                              PointXYZHSV* out,
+                              const float* h,
+                              const float* s,
+                              const float* v) {
+    for (int j = 0; j < 8; j++) {
+        out[j].x = in[j].x;
+        out[j].y = in[j].y;
+        out[j].z = in[j].z;
+        out[j].h = h[j];
+        out[j].s = s[j];
+        out[j].v = v[j];
+    }
+}
+
+static void
+convertBatchSSE2(const PointXYZRGB* in, PointXYZHSV* out, size_t num_points) {
+    alignas(16) float h[8], s[8], v[8];
+    for (size_t i = 0; i < num_points; i += 8) {
+        convert4SSE2(in + i, h, s, v);
+        convert4SSE2(in + i + 4, h + 4, s + 4, v + 4);
+        writeBatch(in + i, out + i, h, s, v);
+    }
+}
+
+// Converts 8 points at a time with AVX2, only called if the CPU supports it
+__attribute__((target("avx2"))) static void
+convertBatchAVX2(const PointXYZRGB* in, PointXYZHSV* out, size_t num_points) {
+    // rgba of consecutive points are sizeof(PointXYZRGB) bytes apart
+    const int stride           = sizeof(PointXYZRGB) / sizeof(int);
+    const __m256i gather_index = _mm256_mullo_epi32(
+    _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+
+    const __m256i byte_mask = _mm256_set1_epi32(0xff);
+    const __m256 zero       = _mm256_setzero_ps();
+    const __m256 two        = _mm256_set1_ps(2.f);
+    const __m256 all_ones   = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    alignas(32) float h[8], s[8], v[8];
+
+    for (size_t i = 0; i < num_points; i += 8) {
+        const __m256i rgba = _mm256_i32gather_epi32(
+        reinterpret_cast<const int*>(&in[i].rgba), gather_index, 4);
+        const __m256 r = _mm256_cvtepi32_ps(
+        _mm256_and_si256(_mm256_srli_epi32(rgba, 16), byte_mask));
+        const __m256 g = _mm256_cvtepi32_ps(
+        _mm256_and_si256(_mm256_srli_epi32(rgba, 8), byte_mask));
+        const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(rgba, byte_mask));
+
+        const __m256 max  = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const __m256 min  = _mm256_min_ps(r, _mm256_min_ps(g, b));
+        const __m256 diff = _mm256_sub_ps(max, min);
+
+        __m256 max_reciprocal = _mm256_rcp_ps(max);
+        max_reciprocal        = _mm256_mul_ps(
+        max_reciprocal, _mm256_sub_ps(two, _mm256_mul_ps(max, max_reciprocal)));
+        __m256 diff_reciprocal = _mm256_rcp_ps(diff);
+        diff_reciprocal =
+        _mm256_mul_ps(diff_reciprocal,
+                      _mm256_sub_ps(two, _mm256_mul_ps(diff, diff_reciprocal)));
+
+        const __m256 v_out = _mm256_mul_ps(max, _mm256_set1_ps(1.f / 255.f));
+
+        const __m256 max_is_zero = _mm256_cmp_ps(max, zero, _CMP_EQ_OQ);
+        const __m256 s_out =
+        _mm256_andnot_ps(max_is_zero, _mm256_mul_ps(diff, max_reciprocal));
+
+        const __m256 max_is_r = _mm256_cmp_ps(max, r, _CMP_EQ_OQ);
+        const __m256 max_is_g =
+        _mm256_andnot_ps(max_is_r, _mm256_cmp_ps(max, g, _CMP_EQ_OQ));
+        const __m256 max_is_b =
+        _mm256_andnot_ps(_mm256_or_ps(max_is_r, max_is_g), all_ones);
+
+        const __m256 numerator = _mm256_blendv_ps(
+        _mm256_blendv_ps(_mm256_sub_ps(r, g), _mm256_sub_ps(b, r), max_is_g),
+        _mm256_sub_ps(g, b),
+        max_is_r);
+        const __m256 offset =
+        _mm256_or_ps(_mm256_and_ps(max_is_g, two),
+                     _mm256_and_ps(max_is_b, _mm256_set1_ps(4.f)));
+
+        __m256 h_out = _mm256_mul_ps(
+        _mm256_set1_ps(60.f),
+        _mm256_add_ps(offset, _mm256_mul_ps(numerator, diff_reciprocal)));
+
+        h_out =
+        _mm256_add_ps(h_out,
+                      _mm256_and_ps(_mm256_cmp_ps(h_out, zero, _CMP_LT_OQ),
+                                    _mm256_set1_ps(360.f)));
+        h_out = _mm256_andnot_ps(_mm256_cmp_ps(diff, zero, _CMP_EQ_OQ), h_out);
+
+        _mm256_store_ps(h, h_out);
+        _mm256_store_ps(s, s_out);
+        _mm256_store_ps(v, v_out);
+        writeBatch(in + i, out + i, h, s, v);
+    }
+}
+#endif
+
 ColourspaceConverter::ColourspaceConverter() {}
 
 void ColourspaceConverter::setInputCloud(PointCloud<PointXYZRGB>::Ptr input) {
@@ -18,6 +193,7 @@ void ColourspaceConverter::convert(PointCloud<PointXYZHSV>& output) {
     output.width  = cloud_->width;
     output.height = cloud_->height;
     output.header = cloud_->header;
+    output.points.reserve(output.points.size() + cloud_->size());
     for (size_t i = 0; i < cloud_->size(); i++) {
         PointXYZHSV p;
         ColourspaceConverter::PointXYZRGBAtoXYZHSV(cloud_->points[i], p);
@@ -25,40 +201,77 @@ void ColourspaceConverter::convert(PointCloud<PointXYZHSV>& output) {
     }
 }
 
+void ColourspaceConverter::convertBatch(PointCloud<PointXYZHSV>& output) {
+    const size_t num_points = cloud_->size();
+
+    output.width  = cloud_->width;
+    output.height = cloud_->height;
+    output.header = cloud_->header;
+    output.points.resize(num_points);
+
+    const PointXYZRGB* in = cloud_->points.data();
+    PointXYZHSV* out      = output.points.data();
+
+    size_t num_batched = 0;
+#ifdef __SSE2__
+    // The kernels work on 8 points at a time, the rest are converted below
+    num_batched = num_points - num_points % 8;
+
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    if (has_avx2) {
+        convertBatchAVX2(in, out, num_batched);
+    } else {
+        convertBatchSSE2(in, out, num_batched);
+    }
+#endif
+
+    for (size_t i = num_batched; i < num_points; i++) {
+        PointXYZRGBAtoXYZHSV(in[i], out[i]);
+    }
+}
+
 void ColourspaceConverter::PointXYZRGBAtoXYZHSV(const PointXYZRGB& in,
                                                 PointXYZHSV& out) {
     out.x = in.x;
     out.y = in.y;
     out.z = in.z;
 
-    const unsigned char max = std::max(in.r, std::max(in.g, in.b));
-    const unsigned char min = std::min(in.r, std::min(in.g, in.b));
+    rgbToHsv(in.r, in.g, in.b, out.h, out.s, out.v);
+}
+
+void ColourspaceConverter::rgbToHsv(unsigned char r,
+                                    unsigned char g,
+                                    unsigned char b,
+                                    float& h,
+                                    float& s,
+                                    float& v) {
+    const unsigned char max = std::max(r, std::max(g, b));
+    const unsigned char min = std::min(r, std::min(g, b));
 
-    out.v = static_cast<float>(max) / 255.f;
+    v = static_cast<float>(max) / 255.f;
 
     if (max == 0) // rgb values of zero maps to hsv 0, 0, 0
     {
-        out.s = 0.f;
-        out.h = 0.f;
+        s = 0.f;
+        h = 0.f;
         return;
     }
 
     const float diff = static_cast<float>(max - min);
-    out.s            = diff / static_cast<float>(max);
+    s                = diff / static_cast<float>(max);
 
     if (min == max) // diff == 0 -> division by zero, set h to zero
     {
-        out.h = 0;
+        h = 0;
         return;
     }
 
-    if (max == in.r)
-        out.h = 60.f * (static_cast<float>(in.g - in.b) / diff);
-    else if (max == in.g)
-        out.h = 60.f * (2.f + static_cast<float>(in.b - in.r) / diff);
+    if (max == r)
+        h = 60.f * (static_cast<float>(g - b) / diff);
+    else if (max == g)
+        h = 60.f * (2.f + static_cast<float>(b - r) / diff);
     else
-        out.h =
-        60.f * (4.f + static_cast<float>(in.r - in.g) / diff); // max == b
+        h = 60.f * (4.f + static_cast<float>(r - g) / diff); // max == b
 
-    if (out.h < 0.f) out.h += 360.f;
+    if (h < 0.f) h += 360.f;
 }
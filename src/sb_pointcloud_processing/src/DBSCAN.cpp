@@ -22,7 +22,12 @@ void DBSCAN::setRadius(float new_radius) {
 
 vector<pcl::PointCloud<pcl::PointXYZ>>
 DBSCAN::findClusters(pcl::PointCloud<pcl::PointXYZ>::Ptr pclPtr) {
-    this->_pcl = *pclPtr;
+    return findClusters(PointCloudView(*pclPtr));
+}
+
+vector<pcl::PointCloud<pcl::PointXYZ>>
+DBSCAN::findClusters(const PointCloudView& pclView) {
+    this->_pcl = pclView;
 
     findNeighbors();
 
@@ -0,0 +1,299 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A class which estimates the ground plane of a pointcloud with
+ *              RANSAC and keeps the points within a band around it.
+ */
+
+#include <Eigen/Eigenvalues>
+#include <GroundPlaneSegmenter.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+GroundPlaneSegmenter::GroundPlaneSegmenter(float inlier_threshold,
+                                           float max_tilt,
+                                           unsigned int max_samples,
+                                           unsigned int max_iterations,
+                                           float time_budget_ms,
+                                           unsigned int seed)
+  : plane_(0, 0, 1, 0),
+    inlier_threshold_(inlier_threshold),
+    min_cos_tilt_(std::cos(max_tilt)),
+    max_samples_(max_samples),
+    max_iterations_(max_iterations),
+    time_budget_ms_(time_budget_ms),
+    min_inlier_ratio_(0.2),
+    min_distance_(-0.05),
+    max_distance_(0.1),
+    has_transform_(false),
+    transform_(Eigen::Affine3f::Identity()),
+    generator_(seed) {}
+
+void GroundPlaneSegmenter::setBand(float min, float max) {
+    min_distance_ = min;
+    max_distance_ = max;
+}
+
+void GroundPlaneSegmenter::setMinInlierRatio(float min_inlier_ratio) {
+    min_inlier_ratio_ = min_inlier_ratio;
+}
+
+void GroundPlaneSegmenter::setTransform(const Eigen::Affine3f& transform) {
+    transform_     = transform;
+    has_transform_ = true;
+}
+
+void GroundPlaneSegmenter::clearTransform() {
+    transform_     = Eigen::Affine3f::Identity();
+    has_transform_ = false;
+}
+
+const Eigen::Vector4f& GroundPlaneSegmenter::plane() const {
+    return plane_;
+}
+
+void GroundPlaneSegmenter::reset() {
+    plane_ = Eigen::Vector4f(0, 0, 1, 0);
+}
+
+bool GroundPlaneSegmenter::segment(const sensor_msgs::PointCloud2& input,
+                                   sensor_msgs::PointCloud2& output) {
+    return updatePlane(input) && filter(input, output);
+}
+
+bool GroundPlaneSegmenter::findFields(const sensor_msgs::PointCloud2& input,
+                                      int& x_offset,
+                                      int& y_offset,
+                                      int& z_offset) const {
+    x_offset = y_offset = z_offset = -1;
+    for (const sensor_msgs::PointField& field : input.fields) {
+        if (field.datatype != sensor_msgs::PointField::FLOAT32) continue;
+        if (field.name == "x") x_offset = field.offset;
+        if (field.name == "y") y_offset = field.offset;
+        if (field.name == "z") z_offset = field.offset;
+    }
+    if (x_offset < 0 || y_offset < 0 || z_offset < 0) { return false; }
+
+    // Make sure every point and field we read lies within the data, so a
+    // malformed or truncated cloud is rejected instead of read past its end
+    uint64_t field_end =
+    std::max(x_offset, std::max(y_offset, z_offset)) + sizeof(float);
+    return (uint64_t) input.height * input.row_step <= input.data.size() &&
+           (uint64_t) input.width * input.point_step <= input.row_step &&
+           field_end <= input.point_step;
+}
+
+bool GroundPlaneSegmenter::readPoint(const uint8_t* ptr,
+                                     int x_offset,
+                                     int y_offset,
+                                     int z_offset,
+                                     Eigen::Vector3f& p) const {
+    std::memcpy(&p.x(), ptr + x_offset, sizeof(float));
+    std::memcpy(&p.y(), ptr + y_offset, sizeof(float));
+    std::memcpy(&p.z(), ptr + z_offset, sizeof(float));
+    if (!std::isfinite(p.x()) || !std::isfinite(p.y()) ||
+        !std::isfinite(p.z())) {
+        return false;
+    }
+    if (has_transform_) p = transform_ * p;
+    return true;
+}
+
+bool GroundPlaneSegmenter::updatePlane(const sensor_msgs::PointCloud2& input) {
+    int x_offset, y_offset, z_offset;
+    if (!findFields(input, x_offset, y_offset, z_offset)) { return false; }
+
+    // Estimate the plane from evenly spaced points
+    const uint32_t num_points = input.width * input.height;
+    samples_.clear();
+    uint32_t stride = std::max(1u, num_points / std::max(1u, max_samples_));
+    for (uint32_t i = 0; i < num_points; i += stride) {
+        const uint8_t* ptr = &input.data[(i / input.width) * input.row_step +
+                                         (i % input.width) * input.point_step];
+        Eigen::Vector3f p;
+        if (readPoint(ptr, x_offset, y_offset, z_offset, p)) {
+            samples_.push_back(p);
+        }
+    }
+    estimatePlane(samples_);
+
+    return true;
+}
+
+bool GroundPlaneSegmenter::filter(const sensor_msgs::PointCloud2& input,
+                                  sensor_msgs::PointCloud2& output) const {
+    int x_offset, y_offset, z_offset;
+    if (!findFields(input, x_offset, y_offset, z_offset)) { return false; }
+
+    const uint32_t num_points = input.width * input.height;
+    const uint32_t step       = input.point_step;
+
+    output.header       = input.header;
+    output.height       = 1;
+    output.fields       = input.fields;
+    output.is_bigendian = input.is_bigendian;
+    output.is_dense     = true;
+    output.point_step   = step;
+
+    // Allocate for the worst case (every point survives) once, then shrink
+    output.data.resize((size_t) num_points * step);
+    uint8_t* out_ptr = output.data.data();
+
+    const Eigen::Vector3f normal = plane_.head<3>();
+    uint32_t num_kept            = 0;
+    for (uint32_t row = 0; row < input.height; row++) {
+        const uint8_t* in_ptr = &input.data[row * input.row_step];
+        for (uint32_t col = 0; col < input.width; col++, in_ptr += step) {
+            Eigen::Vector3f p;
+            if (!readPoint(in_ptr, x_offset, y_offset, z_offset, p)) continue;
+
+            float distance = normal.dot(p) + plane_[3];
+            if (distance < min_distance_ || distance > max_distance_) continue;
+
+            std::memcpy(out_ptr, in_ptr, step);
+            if (has_transform_) {
+                std::memcpy(out_ptr + x_offset, &p.x(), sizeof(float));
+                std::memcpy(out_ptr + y_offset, &p.y(), sizeof(float));
+                std::memcpy(out_ptr + z_offset, &p.z(), sizeof(float));
+            }
+            out_ptr += step;
+            num_kept++;
+        }
+    }
+
+    output.width    = num_kept;
+    output.row_step = num_kept * step;
+    output.data.resize(output.row_step);
+
+    return true;
+}
+
+bool GroundPlaneSegmenter::estimatePlane(
+const std::vector<Eigen::Vector3f>& points) {
+    const unsigned int num_points = points.size();
+    if (num_points < 3) { return false; }
+
+    const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+    const std::chrono::duration<float, std::milli> time_budget(time_budget_ms_);
+
+    // Warm start from the current plane, which on most clouds is still a
+    // good fit and cuts the number of iterations down to a handful
+    Eigen::Vector4f best_plane = plane_;
+    unsigned int best_inliers;
+    float best_cost = cost(best_plane, points, best_inliers);
+    unsigned int iterations =
+    requiredIterations((double) best_inliers / num_points);
+
+    std::uniform_int_distribution<unsigned int> pick(0, num_points - 1);
+    for (unsigned int k = 0; k < iterations; k++) {
+        if (std::chrono::steady_clock::now() - start >= time_budget) { break; }
+
+        const Eigen::Vector3f& a = points[pick(generator_)];
+        const Eigen::Vector3f& b = points[pick(generator_)];
+        const Eigen::Vector3f& c = points[pick(generator_)];
+
+        Eigen::Vector3f normal = (b - a).cross(c - a);
+        float norm             = normal.norm();
+        // collinear or repeated points
+        if (norm < 1e-6) continue;
+        normal /= norm;
+
+        Eigen::Vector4f plane(
+        normal.x(), normal.y(), normal.z(), -normal.dot(a));
+        if (!orient(plane)) continue;
+
+        unsigned int num_inliers;
+        float plane_cost = cost(plane, points, num_inliers);
+        if (plane_cost < best_cost) {
+            best_cost    = plane_cost;
+            best_plane   = plane;
+            best_inliers = num_inliers;
+            iterations   = std::min(
+            iterations, requiredIterations((double) num_inliers / num_points));
+        }
+    }
+
+    if (best_inliers < min_inlier_ratio_ * num_points) { return false; }
+
+    // Keep the sampled plane if the refined one is no good
+    refine(points, best_plane);
+    plane_ = best_plane;
+    return true;
+}
+
+float GroundPlaneSegmenter::cost(const Eigen::Vector4f& plane,
+                                 const std::vector<Eigen::Vector3f>& points,
+                                 unsigned int& num_inliers) const {
+    const float threshold_squared = inlier_threshold_ * inlier_threshold_;
+    const Eigen::Vector3f normal  = plane.head<3>();
+
+    float total = 0;
+    num_inliers = 0;
+    for (const Eigen::Vector3f& p : points) {
+        float distance = normal.dot(p) + plane[3];
+        float squared  = distance * distance;
+        if (squared <= threshold_squared) {
+            total += squared;
+            num_inliers++;
+        } else {
+            total += threshold_squared;
+        }
+    }
+    return total;
+}
+
+bool GroundPlaneSegmenter::refine(const std::vector<Eigen::Vector3f>& points,
+                                  Eigen::Vector4f& plane) const {
+    const Eigen::Vector3f normal = plane.head<3>();
+
+    Eigen::Vector3d sum         = Eigen::Vector3d::Zero();
+    Eigen::Matrix3d sum_squares = Eigen::Matrix3d::Zero();
+    unsigned int count          = 0;
+    for (const Eigen::Vector3f& p : points) {
+        if (std::abs(normal.dot(p) + plane[3]) > inlier_threshold_) continue;
+        Eigen::Vector3d q = p.cast<double>();
+        sum += q;
+        sum_squares += q * q.transpose();
+        count++;
+    }
+    if (count < 3) { return false; }
+
+    // The normal of the least squares plane is the direction in which the
+    // inliers vary the least
+    Eigen::Vector3d centroid = sum / count;
+    Eigen::Matrix3d covariance =
+    sum_squares / count - centroid * centroid.transpose();
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+    Eigen::Vector3d refined_normal = solver.eigenvectors().col(0);
+
+    Eigen::Vector4f refined(refined_normal.x(),
+                            refined_normal.y(),
+                            refined_normal.z(),
+                            -refined_normal.dot(centroid));
+    if (!refined.allFinite() || !orient(refined)) { return false; }
+
+    plane = refined;
+    return true;
+}
+
+bool GroundPlaneSegmenter::orient(Eigen::Vector4f& plane) const {
+    if (plane[2] < 0) plane = -plane;
+    return plane[2] >= min_cos_tilt_;
+}
+
+unsigned int
+GroundPlaneSegmenter::requiredIterations(double inlier_ratio) const {
+    double outlier_free_probability = std::pow(inlier_ratio, 3);
+
+    if (outlier_free_probability >= 1) { return 1; }
+    if (outlier_free_probability <= 0) { return max_iterations_; }
+
+    double iterations =
+    std::ceil(std::log(0.01) / std::log(1 - outlier_free_probability));
+
+    if (iterations > max_iterations_) { return max_iterations_; }
+    return std::max(1u, (unsigned int) iterations);
+}
@@ -6,8 +6,8 @@
  * References:
  *      Tutorial for pcl_visualizer -
  *          http://pointclouds.org/documentation/tutorials/pcl_visualizer.php
- *      Dynamic Reconfigure for C++ -
- *          http://wiki.ros.org/hokuyo_node/Tutorials/UsingDynparamToChangeHokuyoLaserParameters#PythonAPI
+ *      Dynamic Reconfigure -
+ *          http://wiki.ros.org/dynamic_reconfigure
  */
 
 #include "IGVCVisualizerNode.h"
@@ -18,8 +18,13 @@ float IGVCVisualizerNode::s_margin_of_error;
 float IGVCVisualizerNode::v_margin_of_error;
 
 boost::shared_ptr<pcl::visualization::PCLVisualizer> IGVCVisualizerNode::viewer;
-pcl::PointCloud<pcl::PointXYZRGB>::Ptr IGVCVisualizerNode::raw_visualized_cloud;
-bool IGVCVisualizerNode::isPaused;
+pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr
+IGVCVisualizerNode::raw_visualized_cloud;
+sensor_msgs::PointCloud2::ConstPtr IGVCVisualizerNode::raw_picking_cloud;
+std::atomic<bool> IGVCVisualizerNode::isPaused;
+bool IGVCVisualizerNode::fused_filter;
+boost::shared_ptr<AsyncReconfigureClient>
+IGVCVisualizerNode::reconfigure_client;
 
 IGVCVisualizerNode::IGVCVisualizerNode(int argc,
                                        char** argv,
@@ -38,20 +43,30 @@ IGVCVisualizerNode::IGVCVisualizerNode(int argc,
     // Initialise margin of error and image update rate
     retrieveVisualizerParameters(private_nh);
 
+    reconfigure_client.reset(new AsyncReconfigureClient());
+
+    // Clouds are received on their own queue, the timer below stays on the
+    // global queue spun by the main thread
+    ros::NodeHandle intake_nh;
+    intake_nh.setCallbackQueue(&intake_queue);
+
     // Setup raw pcl subscriber
     std::string raw_pcl_topic = "/input_cloud";
     uint32_t queue_size       = 1;
-    raw_pcl_sub               = nh.subscribe<sensor_msgs::PointCloud2>(
+    raw_pcl_sub               = intake_nh.subscribe<sensor_msgs::PointCloud2>(
     raw_pcl_topic, queue_size, &IGVCVisualizerNode::rawPCLCallBack, this);
 
     // Setup filtered pcl subscriber
     std::string filtered_pcl_topic = "/height_filter/output";
-    filtered_pcl_sub               = nh.subscribe<sensor_msgs::PointCloud2>(
+    filtered_pcl_sub = intake_nh.subscribe<sensor_msgs::PointCloud2>(
     filtered_pcl_topic,
     queue_size,
     &IGVCVisualizerNode::filteredPCLCallBack,
     this);
 
+    intake_spinner.reset(new ros::AsyncSpinner(1, &intake_queue));
+    intake_spinner->start();
+
     // Setup timer callback for updating the camera
     timer = nh.createTimer(ros::Duration(image_update_rate),
                            &IGVCVisualizerNode::updateVisualizerCallback,
@@ -60,71 +75,104 @@ IGVCVisualizerNode::IGVCVisualizerNode(int argc,
 
 void IGVCVisualizerNode::rawPCLCallBack(
 const sensor_msgs::PointCloud2::ConstPtr& input) {
-    // Only update point cloud if system is not paused
+    // Only keep point cloud if system is not paused
     if (!isPaused) {
-        // Obtain the ROS pointcloud and convert into PCL Pointcloud2
-        pcl::PCLPointCloud2::Ptr pcl_input(new pcl::PCLPointCloud2);
-        pcl_conversions::toPCL(*(input), *(pcl_input));
-
-        // Converts from the Pointcloud2 format to PointcloudRGB
-        pcl::PointCloud<pcl::PointXYZRGB>::Ptr pcl_rgb(
-        new pcl::PointCloud<pcl::PointXYZRGB>());
-        pcl::fromPCLPointCloud2(*pcl_input, *pcl_rgb);
-
-        // Remove NaNs from point cloud
-        std::vector<int> indices;
-        pcl::removeNaNFromPointCloud(*pcl_rgb, *pcl_rgb, indices);
-
-        // Renew pcl point data
-        raw_visualized_cloud = pcl_rgb;
-
-        // Remove all old point clouds from the view
-        viewer->removeAllPointClouds(raw_channel);
-
-        // Show the new point cloud retrieved from the camera
-        viewer->addPointCloud(
-        raw_visualized_cloud, "raw_visualized_cloud", raw_channel);
-
-        // Setup how big the points are in the point cloud
-        viewer->setPointCloudRenderingProperties(
-        pcl::visualization::PCL_VISUALIZER_POINT_SIZE,
-        1.0,
-        "raw_visualized_cloud");
+        std::lock_guard<std::mutex> lock(latest_mutex);
+        latest_raw_cloud = input;
     }
 }
 
 void IGVCVisualizerNode::filteredPCLCallBack(
 const sensor_msgs::PointCloud2::ConstPtr& input) {
-    // Only update point cloud if system is not paused
+    // Only keep point cloud if system is not paused
     if (!isPaused) {
-        // Obtain the ROS pointcloud and convert into PCL Pointcloud2
-        pcl::PCLPointCloud2::Ptr pcl_input(new pcl::PCLPointCloud2);
-        pcl_conversions::toPCL(*(input), *(pcl_input));
+        std::lock_guard<std::mutex> lock(latest_mutex);
+        latest_filtered_cloud = input;
+    }
+}
 
-        // Converts from the Pointcloud2 format to PointcloudRGB
-        pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_pcl(
-        new pcl::PointCloud<pcl::PointXYZ>());
-        pcl::fromPCLPointCloud2(*pcl_input, *filtered_pcl);
+template <typename PointT>
+typename pcl::PointCloud<PointT>::ConstPtr
+IGVCVisualizerNode::prepareCloud(const sensor_msgs::PointCloud2& input) {
+    // Obtain the ROS pointcloud and convert into PCL Pointcloud2
+    pcl::PCLPointCloud2::Ptr pcl_input(new pcl::PCLPointCloud2);
+    pcl_conversions::toPCL(input, *pcl_input);
+
+    typename pcl::PointCloud<PointT>::Ptr cloud(new pcl::PointCloud<PointT>());
+    if (voxel_size > 0) {
+        // Decimate before converting, so only the remaining points are
+        // converted. The voxel grid skips NaNs itself.
+        pcl::PCLPointCloud2 decimated;
+        pcl::VoxelGrid<pcl::PCLPointCloud2> voxel_grid;
+        voxel_grid.setInputCloud(pcl_input);
+        voxel_grid.setLeafSize(voxel_size, voxel_size, voxel_size);
+        voxel_grid.filter(decimated);
+
+        pcl::fromPCLPointCloud2(decimated, *cloud);
+    } else {
+        pcl::fromPCLPointCloud2(*pcl_input, *cloud);
 
-        // Remove all old point clouds from the view
-        viewer->removeAllPointClouds(filtered_channel);
+        // Remove NaNs from point cloud
+        std::vector<int> indices;
+        pcl::removeNaNFromPointCloud(*cloud, *cloud, indices);
+    }
 
-        // Show the new filtered cloud retrieved from the camera
-        viewer->addPointCloud(
-        filtered_pcl, "filtered_pcl_rgb", filtered_channel);
+    return cloud;
+}
 
-        // Setup how big the points are in the point cloud
-        viewer->setPointCloudRenderingProperties(
-        pcl::visualization::PCL_VISUALIZER_POINT_SIZE, 1.0, "filtered_pcl_rgb");
-    }
+template <typename PointT>
+void IGVCVisualizerNode::showPointCloud(
+const typename pcl::PointCloud<PointT>::ConstPtr& cloud,
+const pcl::visualization::PointCloudColorHandler<PointT>& colour,
+const std::string& id,
+int channel) {
+    // Replace the points of the existing cloud, rather than building a new
+    // actor every frame
+    if (viewer->updatePointCloud<PointT>(cloud, colour, id)) return;
+
+    // Show the first cloud retrieved from the camera
+    viewer->addPointCloud<PointT>(cloud, colour, id, channel);
+
+    // Setup how big the points are in the point cloud
+    viewer->setPointCloudRenderingProperties(
+    pcl::visualization::PCL_VISUALIZER_POINT_SIZE, 1.0, id);
 }
 
 void IGVCVisualizerNode::updateVisualizerCallback(
 const ros::TimerEvent& event) {
-    // Update the viewer
+    // Only update point clouds if system is not paused
+    if (!isPaused) {
+        // Take the latest clouds, anything received before them is dropped
+        sensor_msgs::PointCloud2::ConstPtr raw_input, filtered_input;
+        {
+            std::lock_guard<std::mutex> lock(latest_mutex);
+            raw_input.swap(latest_raw_cloud);
+            filtered_input.swap(latest_filtered_cloud);
+        }
+
+        if (raw_input) {
+            // Renew pcl point data, points are picked from what is shown
+            raw_visualized_cloud = prepareCloud<pcl::PointXYZRGB>(*raw_input);
+            raw_picking_cloud.reset();
+            if (voxel_size > 0) { raw_picking_cloud = raw_input; }
+            pcl::visualization::PointCloudColorHandlerRGBField<pcl::PointXYZRGB>
+            colour(raw_visualized_cloud);
+            showPointCloud<pcl::PointXYZRGB>(
+            raw_visualized_cloud, colour, "raw_visualized_cloud", raw_channel);
+        }
+
+        if (filtered_input) {
+            pcl::PointCloud<pcl::PointXYZ>::ConstPtr filtered_pcl =
+            prepareCloud<pcl::PointXYZ>(*filtered_input);
+            pcl::visualization::PointCloudColorHandlerCustom<pcl::PointXYZ>
+            colour(filtered_pcl, 255, 255, 255);
+            showPointCloud<pcl::PointXYZ>(
+            filtered_pcl, colour, "filtered_pcl_rgb", filtered_channel);
+        }
+    }
+
+    // Update the viewer, keyboard and mouse callbacks occur in here
     viewer->spinOnce(100);
-    // Should sleep so keyboard and mouse callbacks can occur.
-    boost::this_thread::sleep(boost::posix_time::microseconds(100000));
 }
 
 boost::shared_ptr<pcl::visualization::PCLVisualizer>
@@ -167,50 +215,52 @@ ros::NodeHandle private_nh) {
                 v_margin_of_error,
                 default_v_margin_of_error);
 
+    bool default_fused_filter = true;
+    SB_getParam(private_nh, "fused_filter", fused_filter, default_fused_filter);
+
     float default_image_update_rate = 0.1;
     SB_getParam(private_nh,
                 "image_update_rate",
                 image_update_rate,
                 default_image_update_rate);
-}
 
-void IGVCVisualizerNode::updateFilterParams(float h, float s, float v) {
-    setParameter("hue_filter", "filter_limit_min", h - h_margin_of_error);
-    setParameter("hue_filter", "filter_limit_max", h + h_margin_of_error);
-    setParameter(
-    "saturation_filter", "filter_limit_min", s - s_margin_of_error);
-    setParameter(
-    "saturation_filter", "filter_limit_max", s + s_margin_of_error);
-    setParameter("value_filter", "filter_limit_min", v - v_margin_of_error);
-    setParameter("value_filter", "filter_limit_max", v + v_margin_of_error);
+    float default_voxel_size = 0.02;
+    SB_getParam(private_nh, "voxel_size", voxel_size, default_voxel_size);
 }
 
-void IGVCVisualizerNode::setParameter(std::string node_name,
-                                      std::string param_name,
-                                      float val) {
-    // Run command line arguments to dynamically reconfigure parameter
-    std::string set_command =
-    std::string("rosrun dynamic_reconfigure dynparam set");
-    int err = system((set_command + " " + node_name + " " + param_name + " " +
-                      std::to_string(val))
-                     .c_str());
-    // More detailed info can be found here
-    // http://wiki.ros.org/dynamic_reconfigure
-
-    if (err) {
-        std::cout << "Error occured when setting" << param_name << "for"
-                  << node_name << std::endl;
+void IGVCVisualizerNode::updateFilterParams(float h, float s, float v) {
+    if (fused_filter) {
+        reconfigure_client->setParameters("/hsv_height_filter",
+                                          {{"h_min", h - h_margin_of_error},
+                                           {"h_max", h + h_margin_of_error},
+                                           {"s_min", s - s_margin_of_error},
+                                           {"s_max", s + s_margin_of_error},
+                                           {"v_min", v - v_margin_of_error},
+                                           {"v_max", v + v_margin_of_error}});
+    } else {
+        reconfigure_client->setParameters(
+        "/hue_filter",
+        {{"filter_limit_min", h - h_margin_of_error},
+         {"filter_limit_max", h + h_margin_of_error}});
+        reconfigure_client->setParameters(
+        "/saturation_filter",
+        {{"filter_limit_min", s - s_margin_of_error},
+         {"filter_limit_max", s + s_margin_of_error}});
+        reconfigure_client->setParameters(
+        "/value_filter",
+        {{"filter_limit_min", v - v_margin_of_error},
+         {"filter_limit_max", v + v_margin_of_error}});
     }
 }
 
 void IGVCVisualizerNode::pointPickEventOccurred(
 const pcl::visualization::PointPickingEvent& event, void* viewer_void) {
-    // Pause any updates to the visualizer
-    isPaused = true;
-
     // Retrieve the RGB point that was selected
     pcl::PointXYZRGB rgb_point =
     raw_visualized_cloud->points.at(event.getPointIndex());
+    // The filters are calibrated with colours the camera saw, not ones
+    // averaged over a voxel
+    if (raw_picking_cloud) { rgb_point = findNearestRawPoint(rgb_point); }
     pcl::PointXYZHSV hsv_point;
 
     // Convert retrieved RGB point to HSV
@@ -232,12 +282,30 @@ const pcl::visualization::PointPickingEvent& event, void* viewer_void) {
     std::cout << std::endl;
 
     std::cout << "Updating filter parameters..." << std::endl;
-    // Dynamically reconfigure filter parameters
-    updateFilterParams(hsv_point.h, hsv_point.s, hsv_point.z);
-    std::cout << "Finished updating filter parameters." << std::endl;
+    // Dynamically reconfigure filter parameters, in the background so the
+    // viewer keeps updating in the meantime
+    updateFilterParams(hsv_point.h, hsv_point.s, hsv_point.v);
+}
 
-    // Resume any updates to the visualizer
-    isPaused = false;
+pcl::PointXYZRGB
+IGVCVisualizerNode::findNearestRawPoint(const pcl::PointXYZRGB& point) {
+    pcl::PCLPointCloud2 pcl_raw;
+    pcl_conversions::toPCL(*raw_picking_cloud, pcl_raw);
+    pcl::PointCloud<pcl::PointXYZRGB> raw;
+    pcl::fromPCLPointCloud2(pcl_raw, raw);
+
+    pcl::PointXYZRGB nearest = point;
+    float nearest_distance   = std::numeric_limits<float>::infinity();
+    for (const pcl::PointXYZRGB& raw_point : raw.points) {
+        if (!pcl::isFinite(raw_point)) continue;
+        float distance =
+        (raw_point.getVector3fMap() - point.getVector3fMap()).squaredNorm();
+        if (distance < nearest_distance) {
+            nearest          = raw_point;
+            nearest_distance = distance;
+        }
+    }
+    return nearest;
 }
 
 void IGVCVisualizerNode::keyboardEventOccurred(
@@ -5,14 +5,10 @@
  */
 
 #include <LineExtractorNode.h>
+#include <algorithm>
 
-LineExtractorNode::LineExtractorNode(int argc,
-                                     char** argv,
-                                     std::string node_name) {
-    ros::init(argc, argv, node_name);
-    ros::NodeHandle nh;
-    ros::NodeHandle private_nh("~");
-
+LineExtractorNode::LineExtractorNode(ros::NodeHandle& nh,
+                                     ros::NodeHandle& private_nh) {
     std::string degree_polynomial_param = "degree_polynomial";
     int default_degree_polynomial       = 3;
     SB_getParam(private_nh,
@@ -47,10 +43,155 @@ LineExtractorNode::LineExtractorNode(int argc,
     std::string default_frame_id = "line_extractor_test";
     SB_getParam(private_nh, frame_id_param, this->frame_id, default_frame_id);
 
-    if (areParamsInvalid()) {
-        ROS_DEBUG(
+    std::string robust_fitting_param = "robust_fitting";
+    bool default_robust_fitting      = false;
+    SB_getParam(private_nh,
+                robust_fitting_param,
+                this->robustFitting,
+                default_robust_fitting);
+
+    // the following params are only used when robust_fitting is set
+    std::string inlier_threshold_param = "inlier_threshold";
+    float default_inlier_threshold     = 0.05;
+    float inlier_threshold;
+    SB_getParam(private_nh,
+                inlier_threshold_param,
+                inlier_threshold,
+                default_inlier_threshold);
+
+    std::string ransac_confidence_param = "ransac_confidence";
+    float default_ransac_confidence     = 0.99;
+    float ransac_confidence;
+    SB_getParam(private_nh,
+                ransac_confidence_param,
+                ransac_confidence,
+                default_ransac_confidence);
+
+    std::string ransac_max_iterations_param = "ransac_max_iterations";
+    int default_ransac_max_iterations       = 200;
+    SB_getParam(private_nh,
+                ransac_max_iterations_param,
+                this->ransacMaxIterations,
+                default_ransac_max_iterations);
+
+    std::string ransac_time_budget_param = "ransac_time_budget_ms";
+    float default_ransac_time_budget     = 5;
+    SB_getParam(private_nh,
+                ransac_time_budget_param,
+                this->ransacTimeBudget,
+                default_ransac_time_budget);
+
+    std::string ransac_seed_param = "ransac_seed";
+    int default_ransac_seed       = 123;
+    int ransac_seed;
+    SB_getParam(
+    private_nh, ransac_seed_param, ransac_seed, default_ransac_seed);
+
+    // negative values are rejected below, rather than wrapping around
+    this->ransac_regression =
+    RansacRegression(inlier_threshold,
+                     ransac_confidence,
+                     std::max(this->ransacMaxIterations, 0),
+                     std::max(this->ransacTimeBudget, 0.0f),
+                     ransac_seed);
+
+    std::string voxel_size_param = "voxel_size";
+    float default_voxel_size     = 0;
+    float voxel_size;
+    SB_getParam(private_nh, voxel_size_param, voxel_size, default_voxel_size);
+
+    std::string voxel_use_z_param = "voxel_use_z";
+    bool default_voxel_use_z      = false;
+    bool voxel_use_z;
+    SB_getParam(
+    private_nh, voxel_use_z_param, voxel_use_z, default_voxel_use_z);
+
+    std::string max_points_param = "max_points";
+    int default_max_points       = 0;
+    int max_points;
+    SB_getParam(private_nh, max_points_param, max_points, default_max_points);
+
+    this->downsample = voxel_size > 0 || max_points > 0;
+    this->downsampler =
+    VoxelGridDownsampler(std::max(voxel_size, 0.0f),
+                         voxel_use_z,
+                         (unsigned int) std::max(max_points, 0));
+
+    std::string tracking_param = "tracking";
+    bool default_tracking      = false;
+    SB_getParam(private_nh, tracking_param, this->tracking, default_tracking);
+
+    std::string track_inlier_threshold_param = "track_inlier_threshold";
+    float default_track_inlier_threshold     = 0.05;
+    float track_inlier_threshold;
+    SB_getParam(private_nh,
+                track_inlier_threshold_param,
+                track_inlier_threshold,
+                default_track_inlier_threshold);
+
+    std::string track_min_inliers_param = "track_min_inliers";
+    int default_track_min_inliers       = 30;
+    int track_min_inliers;
+    SB_getParam(private_nh,
+                track_min_inliers_param,
+                track_min_inliers,
+                default_track_min_inliers);
+
+    std::string track_max_unexplained_ratio_param =
+    "track_max_unexplained_ratio";
+    float default_track_max_unexplained_ratio = 0.2;
+    float track_max_unexplained_ratio;
+    SB_getParam(private_nh,
+                track_max_unexplained_ratio_param,
+                track_max_unexplained_ratio,
+                default_track_max_unexplained_ratio);
+
+    std::string track_process_noise_param = "track_process_noise";
+    float default_track_process_noise     = 0.01;
+    float track_process_noise;
+    SB_getParam(private_nh,
+                track_process_noise_param,
+                track_process_noise,
+                default_track_process_noise);
+
+    std::string track_measurement_noise_param = "track_measurement_noise";
+    float default_track_measurement_noise     = 0.05;
+    float track_measurement_noise;
+    SB_getParam(private_nh,
+                track_measurement_noise_param,
+                track_measurement_noise,
+                default_track_measurement_noise);
+
+    std::string track_max_misses_param = "track_max_misses";
+    int default_track_max_misses       = 2;
+    int track_max_misses;
+    SB_getParam(private_nh,
+                track_max_misses_param,
+                track_max_misses,
+                default_track_max_misses);
+
+    this->line_tracker = LineTracker(std::max(this->degreePoly, 0),
+                                     track_inlier_threshold,
+                                     std::max(track_min_inliers, 0),
+                                     track_max_unexplained_ratio,
+                                     track_process_noise,
+                                     track_measurement_noise,
+                                     std::max(track_max_misses, 0));
+
+    std::string publish_individual_obstacles_param =
+    "publish_individual_obstacles";
+    bool default_publish_individual_obstacles = false;
+    SB_getParam(private_nh,
+                publish_individual_obstacles_param,
+                this->publishIndividualObstacles,
+                default_publish_individual_obstacles);
+
+    // Don't shut ROS down here, as we may be sharing a nodelet manager
+    valid = !areParamsInvalid();
+    if (!valid) {
+        ROS_ERROR(
         "Detected invalid params - make sure all params are positive");
-        ros::shutdown();
+        return;
     }
 
     std::string topic_to_subscribe_to = "input_pointcloud"; // dummy topic name
@@ -58,90 +199,161 @@ LineExtractorNode::LineExtractorNode(int argc,
     subscriber                        = nh.subscribe(
     topic_to_subscribe_to, refresh_rate, &LineExtractorNode::pclCallBack, this);
 
-    std::string topic_to_publish_to =
-    "output_line_obstacle"; // dummy topic name
-    uint32_t queue_size = 1;
-    publisher           = private_nh.advertise<mapping_igvc::LineObstacle>(
-    topic_to_publish_to, queue_size);
+    std::string array_topic_to_publish_to = "output_line_obstacles";
+    uint32_t queue_size                   = 1;
+    array_publisher = private_nh.advertise<mapping_igvc::LineObstacleArray>(
+    array_topic_to_publish_to, queue_size);
+
+    if (this->publishIndividualObstacles) {
+        std::string topic_to_publish_to =
+        "output_line_obstacle"; // dummy topic name
+        publisher = private_nh.advertise<mapping_igvc::LineObstacle>(
+        topic_to_publish_to, queue_size);
+    }
+
+    // markers are only built when subscribed to, at most debug_rate times
+    // a second, and off the callback thread
+    std::string debug_rate_param = "debug_rate";
+    double default_debug_rate    = 10.0;
+    double debug_rate;
+    SB_getParam(private_nh, debug_rate_param, debug_rate, default_debug_rate);
 
     std::string rviz_line_topic = "debug/output_line_obstacle";
-    rviz_line_publisher = private_nh.advertise<visualization_msgs::Marker>(
-    rviz_line_topic, queue_size);
+    rviz_line_publisher.advertise(private_nh, rviz_line_topic, debug_rate);
 
     std::string rviz_cluster_topic = "debug/clusters";
-    rviz_cluster_publisher = private_nh.advertise<visualization_msgs::Marker>(
-    rviz_cluster_topic, queue_size);
+    rviz_cluster_publisher.advertise(
+    private_nh, rviz_cluster_topic, debug_rate);
 }
 
 void LineExtractorNode::pclCallBack(
 const sensor_msgs::PointCloud2ConstPtr processed_pcl) {
-    pcl::PCLPointCloud2 pcl_pc2;
-
-    // convert sensor_msgs::PointCloud2 to pcl::PCLPointCloud2
-    pcl_conversions::toPCL(*processed_pcl, pcl_pc2);
-
-    pcl::PointCloud<pcl::PointXYZ>::Ptr temp_cloud(
-    new pcl::PointCloud<pcl::PointXYZ>);
-
-    // convert pcl::PointCloud2 to pcl::PointCloud<pcl::PointXYZ>
-    pcl::fromPCLPointCloud2(pcl_pc2, *temp_cloud);
-
-    // store converted pointcloud for use
-    this->pclPtr = temp_cloud;
+    // keep the message alive while we read from it
+    this->pclMsg = processed_pcl;
 
     // extract lines from the pointcloud
     extractLines();
 
+    // release the message so its buffer can be freed
+    this->pclMsg.reset();
+
     return;
 }
 
 void LineExtractorNode::extractLines() {
-    DBSCAN dbscan(this->minNeighbours, this->radius);
-    this->clusters = dbscan.findClusters(this->pclPtr);
+    PointCloudView pcl_view(*this->pclMsg);
+    if (pcl_view.empty() && this->pclMsg->width * this->pclMsg->height > 0) {
+        ROS_WARN_THROTTLE(5, "PointCloud needs float x and y fields");
+    }
 
-    std::vector<Eigen::VectorXf> lines = regression.getLinesOfBestFit(
-    this->clusters, this->degreePoly, this->lambda);
+    if (this->downsample) {
+        downsampler.downsample(pcl_view, this->downsampled);
+        pcl_view = PointCloudView(this->downsampled);
+    }
 
-    std::vector<mapping_igvc::LineObstacle> line_obstacles =
-    vectorsToMsgs(lines);
+    // Frames the tracks still explain don't need to be clustered again
+    if (this->tracking && line_tracker.verify(pcl_view, this->lambda)) {
+        this->clusters = line_tracker.getInliers();
+    } else {
+        DBSCAN dbscan(this->minNeighbours, this->radius);
+        this->clusters = dbscan.findClusters(pcl_view);
+
+        std::vector<Eigen::VectorXf> lines;
+        if (this->robustFitting) {
+            lines = ransac_regression.getLinesOfBestFit(
+            this->clusters, this->degreePoly, this->lambda);
+        } else {
+            lines = regression.getLinesOfBestFit(
+            this->clusters, this->degreePoly, this->lambda);
+        }
+
+        if (!this->tracking) {
+            publishLines(vectorsToMsgs(lines));
+            return;
+        }
+        line_tracker.update(lines, this->clusters);
+    }
+
+    publishLines(tracksToMsgs());
+}
+
+void LineExtractorNode::publishLines(
+std::vector<mapping_igvc::LineObstacle> line_obstacles) {
+    // One message per frame, even if it has no lines, so consumers can tell
+    // frames apart. Published as a shared pointer so nodelets in the same
+    // manager receive it without a copy.
+    mapping_igvc::LineObstacleArray::Ptr line_array(
+    new mapping_igvc::LineObstacleArray());
+    line_array->header           = this->pclMsg->header;
+    line_array->num_coefficients = this->degreePoly + 1;
+    line_array->coefficients.reserve(line_obstacles.size() *
+                                     line_array->num_coefficients);
+    line_array->x_min.reserve(line_obstacles.size());
+    line_array->x_max.reserve(line_obstacles.size());
 
     for (unsigned int i = 0; i < line_obstacles.size(); i++) {
-        publisher.publish(line_obstacles[i]);
+        mapping_igvc::LineObstacle& line_obstacle = line_obstacles[i];
+        line_obstacle.header                      = this->pclMsg->header;
+
+        line_array->coefficients.insert(line_array->coefficients.end(),
+                                        line_obstacle.coefficients.begin(),
+                                        line_obstacle.coefficients.end());
+        line_array->x_min.push_back(line_obstacle.x_min);
+        line_array->x_max.push_back(line_obstacle.x_max);
+
+        if (this->publishIndividualObstacles) {
+            publisher.publish(line_obstacle);
+        }
     }
 
+    array_publisher.publish(line_array);
+
     visualizeClusters();
-    visualizeLineObstacles(line_obstacles);
+    visualizeLineObstacles(std::move(line_obstacles));
 
     return;
 }
 
 void LineExtractorNode::visualizeClusters() {
-    std::vector<geometry_msgs::Point> cluster_points;
-    std::vector<std_msgs::ColorRGBA> colors;
-    convertClustersToPointsWithColors(this->clusters, cluster_points, colors);
-
-    visualization_msgs::Marker::_scale_type scale =
-    snowbots::RvizUtils::createrMarkerScale(
-    this->scale, this->scale, this->scale);
-
-    std::string ns = "debug";
-
-    visualization_msgs::Marker marker = snowbots::RvizUtils::createMarker(
-    cluster_points, colors, scale, this->frame_id, ns);
-
-    rviz_cluster_publisher.publish(marker);
+    // the clusters are still needed after this, so only copy them if the
+    // marker is going out
+    if (!rviz_cluster_publisher.isActive()) return;
+
+    rviz_cluster_publisher.publish([
+        clusters = this->clusters,
+        scale    = this->scale,
+        frame_id = this->frame_id
+    ] {
+        std::vector<geometry_msgs::Point> cluster_points;
+        std::vector<std_msgs::ColorRGBA> colors;
+        convertClustersToPointsWithColors(clusters, cluster_points, colors);
+
+        return snowbots::RvizUtils::createMarker(
+        std::move(cluster_points),
+        std::move(colors),
+        snowbots::RvizUtils::createrMarkerScale(scale, scale, scale),
+        frame_id,
+        "debug");
+    });
 }
 
 void LineExtractorNode::convertClustersToPointsWithColors(
-std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters,
+const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
 std::vector<geometry_msgs::Point>& cluster_points,
 std::vector<std_msgs::ColorRGBA>& colors) {
     std::vector<float> color_library_r = {1.0, 0.0, 0.0};
     std::vector<float> color_library_g = {0.0, 0.0, 1.0};
     std::vector<float> color_library_b = {0.0, 1.0, 0.0};
 
+    size_t num_points = 0;
+    for (const pcl::PointCloud<pcl::PointXYZ>& cluster : clusters) {
+        num_points += cluster.size();
+    }
+    cluster_points.reserve(cluster_points.size() + num_points);
+    colors.reserve(colors.size() + num_points);
+
     for (unsigned int c = 0; c < clusters.size(); c++) {
-        pcl::PointCloud<pcl::PointXYZ> cluster = clusters[c];
+        const pcl::PointCloud<pcl::PointXYZ>& cluster = clusters[c];
 
         // assign color to this cluster
         std_msgs::ColorRGBA color;
@@ -153,7 +365,7 @@ std::vector<std_msgs::ColorRGBA>& colors) {
 
         // push all the points in this cluster along with its color
         for (unsigned int p = 0; p < cluster.size(); p++) {
-            pcl::PointXYZ pcl_point = cluster[p];
+            const pcl::PointXYZ& pcl_point = cluster[p];
 
             geometry_msgs::Point msg_point;
             msg_point.x = pcl_point.x;
@@ -167,46 +379,41 @@ std::vector<std_msgs::ColorRGBA>& colors) {
 
 void LineExtractorNode::visualizeLineObstacles(
 std::vector<mapping_igvc::LineObstacle> line_obstacles) {
-    std::vector<geometry_msgs::Point> lines_points =
-    convertLineObstaclesToPoints(line_obstacles);
-
-    visualization_msgs::Marker::_color_type color =
-    snowbots::RvizUtils::createMarkerColor(0.0, 1.0, 1.0, 1.0);
-    visualization_msgs::Marker::_scale_type scale =
-    snowbots::RvizUtils::createrMarkerScale(
-    this->scale, this->scale, this->scale);
-
-    std::string ns = "debug";
-
-    visualization_msgs::Marker marker =
-    snowbots::RvizUtils::createMarker(lines_points,
-                                      color,
-                                      scale,
-                                      this->frame_id,
-                                      ns,
-                                      visualization_msgs::Marker::POINTS);
-
-    rviz_line_publisher.publish(marker);
+    rviz_line_publisher.publish([
+        line_obstacles = std::move(line_obstacles),
+        x_delta        = this->x_delta,
+        scale          = this->scale,
+        frame_id       = this->frame_id
+    ] {
+        return snowbots::RvizUtils::createMarker(
+        convertLineObstaclesToPoints(line_obstacles, x_delta),
+        snowbots::RvizUtils::createMarkerColor(0.0, 1.0, 1.0, 1.0),
+        snowbots::RvizUtils::createrMarkerScale(scale, scale, scale),
+        frame_id,
+        "debug",
+        visualization_msgs::Marker::POINTS);
+    });
 }
 
 std::vector<geometry_msgs::Point>
 LineExtractorNode::convertLineObstaclesToPoints(
-std::vector<mapping_igvc::LineObstacle> line_obstacles) {
+const std::vector<mapping_igvc::LineObstacle>& line_obstacles, float x_delta) {
     std::vector<geometry_msgs::Point> line_points;
+    if (x_delta <= 0) return line_points;
+
     // iterate through all lines
-    for (unsigned int i = 0; i < line_obstacles.size(); i++) {
-        mapping_igvc::LineObstacle line_obstacle = line_obstacles[i];
+    for (const mapping_igvc::LineObstacle& line_obstacle : line_obstacles) {
+        const std::vector<double>& coefficients = line_obstacle.coefficients;
 
         // draw the line as a series of points
         for (float x = line_obstacle.x_min; x < line_obstacle.x_max;
-             x += this->x_delta) {
+             x += x_delta) {
             geometry_msgs::Point p;
             p.x = x;
 
-            // calculate y with a polynomial function
-            for (unsigned int i = 0; i < line_obstacle.coefficients.size();
-                 i++) {
-                p.y += line_obstacle.coefficients[i] * pow(x, i);
+            // calculate y with the polynomial in Horner form
+            for (int i = (int) coefficients.size() - 1; i >= 0; i--) {
+                p.y = p.y * x + coefficients[i];
             }
 
             line_points.push_back(p);
@@ -218,7 +425,24 @@ std::vector<mapping_igvc::LineObstacle> line_obstacles) {
 
 bool LineExtractorNode::areParamsInvalid() {
     return this->degreePoly < 0 || this->lambda < 0 ||
-           this->minNeighbours < 0 || this->radius < 0;
+           this->minNeighbours < 0 || this->radius < 0 ||
+           this->ransacMaxIterations < 0 || this->ransacTimeBudget < 0;
+}
+
+std::vector<mapping_igvc::LineObstacle> LineExtractorNode::tracksToMsgs() {
+    std::vector<mapping_igvc::LineObstacle> msgs;
+
+    for (const LineTracker::Track& track : line_tracker.getTracks()) {
+        mapping_igvc::LineObstacle line_obstacle;
+        for (unsigned int i = 0; i < track.coefficients.size(); i++) {
+            line_obstacle.coefficients.push_back(track.coefficients(i));
+        }
+        line_obstacle.x_min = track.x_min;
+        line_obstacle.x_max = track.x_max;
+        msgs.push_back(line_obstacle);
+    }
+
+    return msgs;
 }
 
 std::vector<mapping_igvc::LineObstacle>
@@ -0,0 +1,229 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class implementation for LineTracker
+ */
+
+#include "LineTracker.h"
+#include "Regression.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LineTracker::LineTracker(unsigned int poly_degree,
+                         float inlier_threshold,
+                         unsigned int min_inliers,
+                         float max_unexplained_ratio,
+                         float process_noise,
+                         float measurement_noise,
+                         unsigned int max_misses)
+  : _poly_degree(poly_degree),
+    _inlier_threshold(inlier_threshold),
+    _min_inliers(min_inliers),
+    _max_unexplained_ratio(max_unexplained_ratio),
+    _process_noise(process_noise),
+    _measurement_noise(measurement_noise),
+    _max_misses(max_misses) {}
+
+void LineTracker::clear() {
+    _tracks.clear();
+    _inliers.clear();
+}
+
+bool LineTracker::verify(const PointCloudView& pcl_view, float lambda) {
+    // inliers of the last frame must not be taken for this one's
+    if (_tracks.empty()) {
+        _inliers.clear();
+        return pcl_view.empty();
+    }
+
+    _inliers.resize(_tracks.size());
+    for (pcl::PointCloud<pcl::PointXYZ>& inliers : _inliers) {
+        inliers.clear();
+    }
+
+    size_t size = pcl_view.size(), num_points = 0, num_unexplained = 0;
+    for (size_t i = 0; i < size; i++) {
+        pcl::PointXYZ point = pcl_view[i];
+        if (!std::isfinite(point.x) || !std::isfinite(point.y)) continue;
+        num_points++;
+
+        // the point belongs to the closest track within the threshold
+        int closest          = -1;
+        float closest_offset = _inlier_threshold;
+        for (unsigned int t = 0; t < _tracks.size(); t++) {
+            const Track& track = _tracks[t];
+            if (point.x < track.x_min - _inlier_threshold ||
+                point.x > track.x_max + _inlier_threshold) {
+                continue;
+            }
+            float offset =
+            std::abs(point.y - evaluate(track.coefficients, point.x));
+            if (offset <= closest_offset) {
+                closest        = t;
+                closest_offset = offset;
+            }
+        }
+
+        if (closest < 0) {
+            num_unexplained++;
+        } else {
+            _inliers[closest].push_back(point);
+        }
+    }
+
+    if (num_unexplained > _max_unexplained_ratio * num_points) { return false; }
+    for (const pcl::PointCloud<pcl::PointXYZ>& inliers : _inliers) {
+        if (inliers.size() < std::max(_min_inliers, _poly_degree + 1)) {
+            return false;
+        }
+    }
+
+    predict();
+    for (unsigned int t = 0; t < _tracks.size(); t++) {
+        const pcl::PointCloud<pcl::PointXYZ>& inliers = _inliers[t];
+
+        float x_min = inliers[0].x, x_max = inliers[0].x;
+        for (const pcl::PointXYZ& point : inliers) {
+            x_min = std::min(x_min, point.x);
+            x_max = std::max(x_max, point.x);
+        }
+
+        correct(_tracks[t],
+                Regression::getLineOfCluster(inliers, _poly_degree, lambda),
+                x_min,
+                x_max);
+        _tracks[t].misses = 0;
+    }
+
+    return true;
+}
+
+void LineTracker::update(
+const std::vector<Eigen::VectorXf>& lines,
+const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters) {
+    predict();
+
+    // x range of each line
+    std::vector<float> x_mins(lines.size()), x_maxs(lines.size());
+    for (unsigned int l = 0; l < lines.size(); l++) {
+        x_mins[l] = std::numeric_limits<float>::max();
+        x_maxs[l] = -std::numeric_limits<float>::max();
+        for (const pcl::PointXYZ& point : clusters[l]) {
+            x_mins[l] = std::min(x_mins[l], point.x);
+            x_maxs[l] = std::max(x_maxs[l], point.x);
+        }
+    }
+
+    // Greedily match the closest track and line pairs, as long as they are
+    // close enough for the line to plausibly be the track
+    const float gate = 3 * _inlier_threshold;
+    std::vector<bool> track_matched(_tracks.size(), false);
+    std::vector<bool> line_matched(lines.size(), false);
+    while (true) {
+        int best_track = -1, best_line = -1;
+        float best_distance = gate;
+        for (unsigned int t = 0; t < _tracks.size(); t++) {
+            if (track_matched[t]) continue;
+            for (unsigned int l = 0; l < lines.size(); l++) {
+                if (line_matched[l] || lines[l].size() != _poly_degree + 1)
+                    continue;
+                float d = distance(_tracks[t], lines[l], x_mins[l], x_maxs[l]);
+                if (d >= 0 && d <= best_distance) {
+                    best_track    = t;
+                    best_line     = l;
+                    best_distance = d;
+                }
+            }
+        }
+        if (best_track < 0) break;
+
+        correct(_tracks[best_track],
+                lines[best_line],
+                x_mins[best_line],
+                x_maxs[best_line]);
+        _tracks[best_track].misses = 0;
+        track_matched[best_track]  = true;
+        line_matched[best_line]    = true;
+    }
+
+    // Drop the tracks that have been missing for too long
+    std::vector<Track> kept_tracks;
+    for (unsigned int t = 0; t < _tracks.size(); t++) {
+        if (!track_matched[t] && ++_tracks[t].misses > _max_misses) continue;
+        kept_tracks.push_back(_tracks[t]);
+    }
+    _tracks.swap(kept_tracks);
+
+    // Start a track for every new line
+    for (unsigned int l = 0; l < lines.size(); l++) {
+        if (line_matched[l] || lines[l].size() != _poly_degree + 1 ||
+            clusters[l].empty()) {
+            continue;
+        }
+        Track track;
+        track.coefficients = lines[l];
+        track.covariance =
+        Eigen::MatrixXf::Identity(_poly_degree + 1, _poly_degree + 1) *
+        _measurement_noise * _measurement_noise;
+        track.x_min  = x_mins[l];
+        track.x_max  = x_maxs[l];
+        track.misses = 0;
+        _tracks.push_back(track);
+    }
+}
+
+void LineTracker::predict() {
+    const float variance = _process_noise * _process_noise;
+    for (Track& track : _tracks) {
+        track.covariance.diagonal().array() += variance;
+    }
+}
+
+void LineTracker::correct(Track& track,
+                          const Eigen::VectorXf& measurement,
+                          float x_min,
+                          float x_max) const {
+    const unsigned int n = track.coefficients.size();
+    Eigen::MatrixXf measurement_covariance =
+    Eigen::MatrixXf::Identity(n, n) * _measurement_noise * _measurement_noise;
+
+    // The coefficients are measured directly, so the gain is simply
+    // P (P + R)^-1
+    Eigen::MatrixXf gain = (track.covariance + measurement_covariance)
+                           .ldlt()
+                           .solve(track.covariance.transpose())
+                           .transpose();
+
+    track.coefficients += gain * (measurement - track.coefficients);
+    track.covariance =
+    (Eigen::MatrixXf::Identity(n, n) - gain) * track.covariance;
+    track.x_min = x_min;
+    track.x_max = x_max;
+}
+
+float LineTracker::distance(const Track& track,
+                            const Eigen::VectorXf& line,
+                            float x_min,
+                            float x_max) {
+    float start = std::max(track.x_min, x_min);
+    float end   = std::min(track.x_max, x_max);
+    if (start > end) { return -1; }
+
+    const int num_samples = 10;
+    float total           = 0;
+    for (int i = 0; i < num_samples; i++) {
+        float x = start + (end - start) * i / (num_samples - 1);
+        total += std::abs(evaluate(track.coefficients, x) - evaluate(line, x));
+    }
+    return total / num_samples;
+}
+
+float LineTracker::evaluate(const Eigen::VectorXf& coefficients, float x) {
+    // Horner's method
+    float y = 0;
+    for (int i = coefficients.size() - 1; i >= 0; i--) {
+        y = y * x + coefficients(i);
+    }
+    return y;
+}
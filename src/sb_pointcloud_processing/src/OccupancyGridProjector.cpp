@@ -0,0 +1,135 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class implementation for OccupancyGridProjector
+ */
+
+#include "OccupancyGridProjector.h"
+#include <cmath>
+#include <cstdlib>
+#include <omp.h>
+
+const int8_t OccupancyGridProjector::GRID_FREE;
+const int8_t OccupancyGridProjector::GRID_OCCUPIED;
+
+OccupancyGridProjector::OccupancyGridProjector(unsigned int width,
+                                               unsigned int height,
+                                               float resolution,
+                                               int8_t unknown_value)
+  : _width(width),
+    _height(height),
+    _resolution(resolution),
+    _unknown_value(unknown_value) {}
+
+void OccupancyGridProjector::project(const PointCloudView& cloud,
+                                     const Eigen::Affine3f& transform,
+                                     const Eigen::Vector2f& grid_origin,
+                                     const Eigen::Vector2f& sensor_origin,
+                                     std::vector<int8_t>& grid) {
+    const int num_cells = _width * _height;
+    const int size      = cloud.size();
+    grid.resize(num_cells);
+    preparePartialGrids();
+
+// 1. Bin the points into each thread's partial grid
+#pragma omp parallel for if (size > (int) _sequential_cut_off)
+    for (int i = 0; i < size; i++) {
+        Eigen::Vector3f point =
+        transform * Eigen::Vector3f(cloud.x(i), cloud.y(i), cloud.z(i));
+        if (!point.allFinite()) continue;
+
+        int col = std::floor((point.x() - grid_origin.x()) / _resolution);
+        int row = std::floor((point.y() - grid_origin.y()) / _resolution);
+        if (col < 0 || row < 0 || col >= (int) _width || row >= (int) _height)
+            continue;
+
+        _partial_grids[omp_get_thread_num()][row * _width + col] = OCCUPIED;
+    }
+
+    // 2. Merge the hits, clearing the partial grids for the rays
+    _occupied.resize(num_cells);
+    const int num_partial_grids = _partial_grids.size();
+#pragma omp parallel for if (num_cells > (int) _sequential_cut_off)
+    for (int c = 0; c < num_cells; c++) {
+        uint8_t hit = 0;
+        for (int t = 0; t < num_partial_grids; t++) {
+            hit |= _partial_grids[t][c];
+            _partial_grids[t][c] = UNKNOWN;
+        }
+        _occupied[c] = hit != 0;
+    }
+
+    _occupied_cells.clear();
+    for (int c = 0; c < num_cells; c++) {
+        if (_occupied[c]) { _occupied_cells.push_back(c); }
+    }
+
+    // 3. Cast a ray from the sensor to each occupied cell
+    const int sensor_col =
+    std::floor((sensor_origin.x() - grid_origin.x()) / _resolution);
+    const int sensor_row =
+    std::floor((sensor_origin.y() - grid_origin.y()) / _resolution);
+    const int num_rays = _occupied_cells.size();
+#pragma omp parallel for schedule(dynamic, 16) if (num_rays > 64)
+    for (int r = 0; r < num_rays; r++) {
+        int c = _occupied_cells[r];
+        castRay(sensor_col,
+                sensor_row,
+                c % _width,
+                c / _width,
+                _partial_grids[omp_get_thread_num()].data());
+    }
+
+// 4. Merge into the output. Occupied cells win over free ones, since rays
+// to other obstacles may pass through them.
+#pragma omp parallel for if (num_cells > (int) _sequential_cut_off)
+    for (int c = 0; c < num_cells; c++) {
+        uint8_t seen = 0;
+        for (int t = 0; t < num_partial_grids; t++) {
+            seen |= _partial_grids[t][c];
+            _partial_grids[t][c] = UNKNOWN;
+        }
+        if (_occupied[c]) {
+            grid[c] = GRID_OCCUPIED;
+        } else {
+            grid[c] = seen ? GRID_FREE : _unknown_value;
+        }
+    }
+}
+
+void OccupancyGridProjector::castRay(
+int x0, int y0, int x1, int y1, uint8_t* partial_grid) const {
+    // Bresenham's line algorithm
+    int dx  = std::abs(x1 - x0);
+    int dy  = -std::abs(y1 - y0);
+    int sx  = x0 < x1 ? 1 : -1;
+    int sy  = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    while (x0 != x1 || y0 != y1) {
+        if (x0 >= 0 && y0 >= 0 && x0 < (int) _width && y0 < (int) _height) {
+            partial_grid[y0 * _width + x0] = FREE;
+        }
+
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void OccupancyGridProjector::preparePartialGrids() {
+    const unsigned int num_cells   = _width * _height;
+    const unsigned int num_threads = omp_get_max_threads();
+
+    if (_partial_grids.size() != num_threads ||
+        (num_threads > 0 && _partial_grids[0].size() != num_cells)) {
+        _partial_grids.assign(num_threads, std::vector<uint8_t>(num_cells));
+    }
+    // Otherwise the grids were already cleared when they were last merged
+}
@@ -0,0 +1,184 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Calculates line of best fit for each cluster of points while
+ *              ignoring outliers (MSAC)
+ */
+
+#include <RansacRegression.h>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+RansacRegression::RansacRegression(float inlier_threshold,
+                                   float confidence,
+                                   unsigned int max_iterations,
+                                   float time_budget_ms,
+                                   unsigned int seed) {
+    this->_inlier_threshold = inlier_threshold;
+    this->_confidence       = confidence;
+    this->_max_iterations   = max_iterations;
+    this->_time_budget_ms   = time_budget_ms;
+    this->_seed             = seed;
+}
+
+std::vector<Eigen::VectorXf> RansacRegression::getLinesOfBestFit(
+const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
+unsigned int poly_degree,
+float lambda) const {
+    std::vector<Eigen::VectorXf> lines(clusters.size());
+
+    unsigned int total_points = 0;
+    for (const pcl::PointCloud<pcl::PointXYZ>& cluster : clusters) {
+        total_points += cluster.size();
+    }
+
+#pragma omp parallel for schedule(dynamic) if (total_points > \
+                                               this->_sequential_cut_off)
+    for (unsigned int i = 0; i < clusters.size(); i++) {
+        lines[i] =
+        getLineOfCluster(clusters[i], poly_degree, lambda, this->_seed + i);
+    }
+
+    return lines;
+}
+
+Eigen::VectorXf RansacRegression::getLineOfCluster(
+const pcl::PointCloud<pcl::PointXYZ>& cluster,
+unsigned int poly_degree,
+float lambda,
+unsigned int seed) const {
+    /*
+     * MSAC: repeatedly fit a polynomial exactly through a minimal sample of
+     * (poly_degree + 1) points and score it by the sum of squared residuals,
+     * where each residual is capped at the inlier threshold. The best scoring
+     * polynomial decides the inliers, which are then refit with least squares.
+     */
+    const unsigned int sample_size = poly_degree + 1;
+
+    // not enough points to tell inliers from outliers
+    if (cluster.size() <= sample_size) {
+        return Regression::getLineOfCluster(cluster, poly_degree, lambda);
+    }
+
+    const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+    const std::chrono::duration<float, std::milli> time_budget(
+    this->_time_budget_ms);
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned int> random_index(
+    0, cluster.size() - 1);
+
+    const double threshold_squared =
+    (double) this->_inlier_threshold * this->_inlier_threshold;
+
+    std::vector<unsigned int> sample(sample_size);
+    Eigen::MatrixXd vandermonde(sample_size, sample_size);
+    Eigen::VectorXd sample_y(sample_size);
+    Eigen::VectorXd model(sample_size);
+
+    Eigen::VectorXd best_model;
+    double best_cost = std::numeric_limits<double>::infinity();
+
+    unsigned int iterations = this->_max_iterations;
+
+    for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+        if (std::chrono::steady_clock::now() - start >= time_budget) { break; }
+
+        // draw a sample of distinct points
+        for (unsigned int s = 0; s < sample_size; s++) {
+            bool is_duplicate;
+            do {
+                sample[s]    = random_index(generator);
+                is_duplicate = false;
+                for (unsigned int t = 0; t < s; t++) {
+                    if (sample[t] == sample[s]) { is_duplicate = true; }
+                }
+            } while (is_duplicate);
+        }
+
+        // fit the polynomial exactly through the sample
+        for (unsigned int s = 0; s < sample_size; s++) {
+            const pcl::PointXYZ& point = cluster[sample[s]];
+            double power               = 1;
+            for (unsigned int j = 0; j < sample_size; j++) {
+                vandermonde(s, j) = power;
+                power *= point.x;
+            }
+            sample_y(s) = point.y;
+        }
+
+        Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(vandermonde);
+        // degenerate sample, e.g. two points with the same x
+        if (qr.rank() < sample_size) { continue; }
+        model = qr.solve(sample_y);
+
+        // score the polynomial, giving up as soon as it can't beat the best
+        double cost          = 0;
+        unsigned int inliers = 0;
+        for (unsigned int i = 0; i < cluster.size() && cost < best_cost; i++) {
+            double residual = cluster[i].y - evaluate(model, cluster[i].x);
+            double residual_squared = residual * residual;
+            if (residual_squared <= threshold_squared) {
+                cost += residual_squared;
+                inliers++;
+            } else {
+                cost += threshold_squared;
+            }
+        }
+
+        if (cost < best_cost) {
+            best_cost  = cost;
+            best_model = model;
+
+            double inlier_ratio = (double) inliers / cluster.size();
+            iterations =
+            std::min(iterations, requiredIterations(inlier_ratio, sample_size));
+        }
+    }
+
+    // every sample was degenerate, or the budget ran out before the first one
+    if (best_model.size() == 0) {
+        return Regression::getLineOfCluster(cluster, poly_degree, lambda);
+    }
+
+    // refit the inliers of the best polynomial with least squares
+    pcl::PointCloud<pcl::PointXYZ> inlier_points;
+    inlier_points.reserve(cluster.size());
+    for (const pcl::PointXYZ& point : cluster) {
+        double residual = point.y - evaluate(best_model, point.x);
+        if (residual * residual <= threshold_squared) {
+            inlier_points.push_back(point);
+        }
+    }
+
+    if (inlier_points.size() < sample_size) { return best_model.cast<float>(); }
+
+    return Regression::getLineOfCluster(inlier_points, poly_degree, lambda);
+}
+
+unsigned int
+RansacRegression::requiredIterations(double inlier_ratio,
+                                     unsigned int sample_size) const {
+    double outlier_free_probability = std::pow(inlier_ratio, sample_size);
+
+    if (outlier_free_probability >= 1) { return 1; }
+    if (outlier_free_probability <= 0) { return this->_max_iterations; }
+
+    double iterations = std::ceil(std::log(1 - this->_confidence) /
+                                  std::log(1 - outlier_free_probability));
+
+    if (iterations > this->_max_iterations) { return this->_max_iterations; }
+    return std::max(1u, (unsigned int) iterations);
+}
+
+double RansacRegression::evaluate(const Eigen::VectorXd& coefficients,
+                                  double x) {
+    // Horner's method
+    double y = 0;
+    for (int i = coefficients.size() - 1; i >= 0; i--) {
+        y = y * x + coefficients(i);
+    }
+    return y;
+}
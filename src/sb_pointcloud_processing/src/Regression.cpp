@@ -6,80 +6,133 @@
 
 #include <Regression.h>
 
+/*
+ * Linear Equation to solve:
+ * (X' * X + lambda * I) * line = X' * y
+ *
+ * X is a matrix of size (n,d) where n is the number of points in the
+ * cluster, and d is the polynomial degree + 1. (+1 for linear bias)
+ * Each row of X represents the x coordinate of a point: the first column is
+ * 1 for linear bias, and the rest of the columns contain pow(x, column).
+ *
+ * lambda is the regularization parameter. The higher this number,
+ * The higher the penalty on the size of the coefficients of the
+ * mathematical lines.
+ *
+ * y is a column vector of size (n), where each row corresponds to the
+ * y coordinate of a point.
+ *
+ * X is never built. Entry (i, j) of X' * X is the sum of x^(i+j) over all
+ * points, and entry i of X' * y is the sum of y * x^i, so both can be
+ * accumulated in a single pass over the cluster. The sums are accumulated in
+ * double since the higher powers of x quickly lose precision in float.
+ */
+
 std::vector<Eigen::VectorXf> Regression::getLinesOfBestFit(
-std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters,
+const std::vector<pcl::PointCloud<pcl::PointXYZ>>& clusters,
 unsigned int poly_degree,
 float lambda) {
-    std::vector<Eigen::VectorXf> lines;
+    std::vector<Eigen::VectorXf> lines(clusters.size());
+
+    unsigned int total_points = 0;
+    for (const pcl::PointCloud<pcl::PointXYZ>& cluster : clusters) {
+        total_points += cluster.size();
+    }
 
-    // Calculate line of best fit for each cluster
+// Calculate line of best fit for each cluster. Clusters vary a lot in size,
+// so they are handed out to threads dynamically.
+#pragma omp parallel for schedule(dynamic) if (total_points > \
+                                               _sequential_cut_off)
     for (unsigned int i = 0; i < clusters.size(); i++) {
-        lines.push_back(getLineOfCluster(clusters[i], poly_degree, lambda));
+        lines[i] = getLineOfCluster(clusters[i], poly_degree, lambda);
     }
 
     return lines;
 }
 
 Eigen::VectorXf
-Regression::getLineOfCluster(pcl::PointCloud<pcl::PointXYZ> cluster,
+Regression::getLineOfCluster(const pcl::PointCloud<pcl::PointXYZ>& cluster,
                              unsigned int poly_degree,
                              float lambda) {
-    unsigned int n = cluster.size();
-
-    /*
-     * Linear Equation to solve:
-     * X' * X + lambda * I = X' * y
-     *
-     * X is a matrix of size (n,d) where n is the number of points in the
-     * cluster,
-     * and d is the polynomial degree + 1. (+1 for linear bias)
-     * Each row of X represents the x coordinate of a point.
-     * Given x for the x coordinate of a point and column for the column index
-     * in the matrix X:
-     * The first column of X is 1 for linear bias, and the rest of the columns
-     * contain the value of pow(x, column-1).
-     *
-     * lambda is the regularization parameter. The higher this number,
-     * The higher the penalty on the size of the coefficients of the
-     * mathematical lines.
-     *
-     * y is a column vector of size (n), where n is the number of points in the
-     * cluster.
-     * Each row of the vector corresponds to the y coordinate of a point.
-     */
-
-    Eigen::MatrixXf X(n, poly_degree + 1);
-    Eigen::VectorXf y(n);
-
-    for (unsigned int i = 0; i < cluster.size(); i++) {
-        pcl::PointXYZ point = cluster[i];
-
-        X.row(i) = constructRow(point.x, poly_degree);
-
-        y(i) = point.y;
+    switch (poly_degree) {
+        case 1: return getLineOfClusterFixed<1>(cluster, lambda);
+        case 2: return getLineOfClusterFixed<2>(cluster, lambda);
+        case 3: return getLineOfClusterFixed<3>(cluster, lambda);
+        default: return getLineOfClusterDynamic(cluster, poly_degree, lambda);
     }
+}
 
-    Eigen::MatrixXf regularization(poly_degree + 1, poly_degree + 1);
-    regularization.setIdentity();
-    regularization *= lambda;
+template <int Degree>
+Eigen::VectorXf
+Regression::getLineOfClusterFixed(const pcl::PointCloud<pcl::PointXYZ>& cluster,
+                                  float lambda) {
+    const int num_coefficients = Degree + 1;
+    const int num_powers       = 2 * Degree + 1;
+
+    Eigen::Matrix<double, num_powers, 1> x_power_sums =
+    Eigen::Matrix<double, num_powers, 1>::Zero();
+    Eigen::Matrix<double, num_coefficients, 1> xy_power_sums =
+    Eigen::Matrix<double, num_coefficients, 1>::Zero();
+
+    Eigen::Matrix<double, num_powers, 1> powers;
+    powers(0) = 1;
+
+    for (const pcl::PointXYZ& point : cluster) {
+        for (int k = 1; k < num_powers; k++) {
+            powers(k) = powers(k - 1) * point.x;
+        }
+
+        x_power_sums += powers;
+        xy_power_sums +=
+        static_cast<double>(point.y) * powers.template head<num_coefficients>();
+    }
 
-    Eigen::MatrixXf left(X.transpose() * X + regularization);
-    Eigen::MatrixXf right(X.transpose() * y);
+    Eigen::Matrix<double, num_coefficients, num_coefficients> left;
+    for (int i = 0; i < num_coefficients; i++) {
+        for (int j = 0; j < num_coefficients; j++) {
+            left(i, j) = x_power_sums(i + j);
+        }
+    }
+    left.diagonal().array() += lambda;
 
-    Eigen::VectorXf line(n);
-    line = (left).ldlt().solve(right);
+    Eigen::Matrix<double, num_coefficients, 1> line =
+    left.ldlt().solve(xy_power_sums);
 
-    return line;
+    return line.template cast<float>();
 }
 
-Eigen::VectorXf Regression::constructRow(float x, unsigned int poly_degree) {
-    Eigen::VectorXf row(poly_degree + 1);
+Eigen::VectorXf Regression::getLineOfClusterDynamic(
+const pcl::PointCloud<pcl::PointXYZ>& cluster,
+unsigned int poly_degree,
+float lambda) {
+    const unsigned int num_coefficients = poly_degree + 1;
+    const unsigned int num_powers       = 2 * poly_degree + 1;
+
+    Eigen::VectorXd x_power_sums  = Eigen::VectorXd::Zero(num_powers);
+    Eigen::VectorXd xy_power_sums = Eigen::VectorXd::Zero(num_coefficients);
 
-    // linear bias
-    row(0) = 1;
+    Eigen::VectorXd powers(num_powers);
+    powers(0) = 1;
 
-    // non-linear
-    for (unsigned int j = 1; j < poly_degree + 1; j++) { row(j) = pow(x, j); }
+    for (const pcl::PointXYZ& point : cluster) {
+        for (unsigned int k = 1; k < num_powers; k++) {
+            powers(k) = powers(k - 1) * point.x;
+        }
+
+        x_power_sums += powers;
+        xy_power_sums +=
+        static_cast<double>(point.y) * powers.head(num_coefficients);
+    }
 
-    return row;
-}
\ No newline at end of file
+    Eigen::MatrixXd left(num_coefficients, num_coefficients);
+    for (unsigned int i = 0; i < num_coefficients; i++) {
+        for (unsigned int j = 0; j < num_coefficients; j++) {
+            left(i, j) = x_power_sums(i + j);
+        }
+    }
+    left.diagonal().array() += lambda;
+
+    Eigen::VectorXd line = left.ldlt().solve(xy_power_sums);
+
+    return line.cast<float>();
+}
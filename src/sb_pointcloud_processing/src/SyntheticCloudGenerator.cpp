@@ -0,0 +1,227 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class implementation for SyntheticCloudGenerator
+ */
+
+#include "SyntheticCloudGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+const uint32_t SyntheticCloudGenerator::LINE_RGB;
+const uint32_t SyntheticCloudGenerator::CONE_RGB;
+const uint32_t SyntheticCloudGenerator::CLUTTER_RGB;
+const size_t SyntheticCloudGenerator::RUN_SIZE;
+
+// x, y, z, rgb as float32
+static const uint32_t POINT_STEP = 16;
+
+/*
+ * Mixes @x into a well distributed 64 bit value (splitmix64), used to derive
+ * independent seeds for each frame and run
+ */
+static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static void writePoint(uint8_t* data, float x, float y, float z, uint32_t rgb) {
+    std::memcpy(data, &x, sizeof(float));
+    std::memcpy(data + 4, &y, sizeof(float));
+    std::memcpy(data + 8, &z, sizeof(float));
+    std::memcpy(data + 12, &rgb, sizeof(uint32_t));
+}
+
+SyntheticCloudGenerator::SyntheticCloudGenerator(unsigned int seed)
+  : _seed(seed), _layout_state(mix(seed)) {}
+
+void SyntheticCloudGenerator::addLine(const Line& line) {
+    _lines.push_back(line);
+    addRuns(Run::LINE, _lines.size() - 1, line.num_points);
+}
+
+void SyntheticCloudGenerator::addCone(const Cone& cone) {
+    _cones.push_back(cone);
+    addRuns(Run::CONE, _cones.size() - 1, cone.num_points);
+}
+
+void SyntheticCloudGenerator::addClutter(const Clutter& clutter) {
+    _clutter.push_back(clutter);
+    addRuns(Run::CLUTTER, _clutter.size() - 1, clutter.num_points);
+}
+
+void SyntheticCloudGenerator::addRandomLines(unsigned int num_lines,
+                                             unsigned int degree,
+                                             float x_min,
+                                             float x_max,
+                                             float y_range,
+                                             unsigned int points_per_line,
+                                             float noise) {
+    // keep the higher order terms from moving y by more than y_range / 2
+    float max_abs_x =
+    std::max(1.f, std::max(std::fabs(x_min), std::fabs(x_max)));
+
+    for (unsigned int l = 0; l < num_lines; l++) {
+        Line line;
+        line.coefficients.push_back(layoutUniform(-y_range, y_range));
+        for (unsigned int d = 1; d <= degree; d++) {
+            float bound = 0.5f * y_range / (degree * std::pow(max_abs_x, d));
+            line.coefficients.push_back(layoutUniform(-bound, bound));
+        }
+        line.x_min      = x_min;
+        line.x_max      = x_max;
+        line.num_points = points_per_line;
+        line.noise_x    = noise;
+        line.noise_y    = noise;
+        addLine(line);
+    }
+}
+
+void SyntheticCloudGenerator::addRandomCones(unsigned int num_cones,
+                                             float x_min,
+                                             float x_max,
+                                             float y_range,
+                                             float radius,
+                                             float height,
+                                             unsigned int points_per_cone) {
+    for (unsigned int c = 0; c < num_cones; c++) {
+        Cone cone;
+        cone.x          = layoutUniform(x_min, x_max);
+        cone.y          = layoutUniform(-y_range, y_range);
+        cone.radius     = radius;
+        cone.height     = height;
+        cone.num_points = points_per_cone;
+        addCone(cone);
+    }
+}
+
+size_t SyntheticCloudGenerator::numPoints() const {
+    return _num_points;
+}
+
+void SyntheticCloudGenerator::generate(sensor_msgs::PointCloud2& cloud) {
+    if (cloud.fields.size() != 4) {
+        const char* names[] = {"x", "y", "z", "rgb"};
+        cloud.fields.resize(4);
+        for (unsigned int i = 0; i < 4; i++) {
+            cloud.fields[i].name     = names[i];
+            cloud.fields[i].offset   = i * sizeof(float);
+            cloud.fields[i].datatype = sensor_msgs::PointField::FLOAT32;
+            cloud.fields[i].count    = 1;
+        }
+    }
+
+    if (_organised_width > 0) {
+        cloud.width  = _organised_width;
+        cloud.height = (_num_points + _organised_width - 1) / _organised_width;
+    } else {
+        cloud.width  = _num_points;
+        cloud.height = 1;
+    }
+    cloud.is_bigendian = false;
+    cloud.point_step   = POINT_STEP;
+    cloud.row_step     = cloud.width * POINT_STEP;
+    cloud.data.resize((size_t) cloud.row_step * cloud.height);
+
+    // pad the last row of an organised cloud with invalid points
+    size_t num_padding = (size_t) cloud.width * cloud.height - _num_points;
+    cloud.is_dense     = num_padding == 0;
+    float nan          = std::numeric_limits<float>::quiet_NaN();
+    for (size_t i = _num_points; i < _num_points + num_padding; i++) {
+        writePoint(&cloud.data[i * POINT_STEP], nan, nan, nan, 0);
+    }
+
+    uint8_t* data = cloud.data.data();
+#pragma omp parallel for schedule(dynamic) if (_runs.size() > 1)
+    for (size_t r = 0; r < _runs.size(); r++) { generateRun(_runs[r], data); }
+
+    _frame++;
+}
+
+void SyntheticCloudGenerator::addRuns(Run::Type type,
+                                      unsigned int element,
+                                      size_t num_points) {
+    for (size_t first = 0; first < num_points; first += RUN_SIZE) {
+        Run run;
+        run.type         = type;
+        run.element      = element;
+        run.first_point  = first;
+        run.first_output = _num_points;
+        run.num_points   = std::min(RUN_SIZE, num_points - first);
+
+        _runs.push_back(run);
+        _num_points += run.num_points;
+    }
+}
+
+float SyntheticCloudGenerator::layoutUniform(float min, float max) {
+    _layout_state = mix(_layout_state);
+    return min + (max - min) * (_layout_state >> 11) * (1.0 / (1ULL << 53));
+}
+
+void SyntheticCloudGenerator::generateRun(const Run& run, uint8_t* data) const {
+    // every run of every frame gets its own stream of random numbers
+    uint64_t run_index = &run - _runs.data();
+    std::mt19937 rng(mix(mix(_seed ^ mix(_frame)) ^ run_index));
+    uint8_t* output = data + run.first_output * POINT_STEP;
+
+    if (run.type == Run::LINE) {
+        const Line& line = _lines[run.element];
+        std::uniform_real_distribution<float> noise_x(-line.noise_x,
+                                                      line.noise_x);
+        std::uniform_real_distribution<float> noise_y(-line.noise_y,
+                                                      line.noise_y);
+        float x_step = line.num_points > 1
+                       ? (line.x_max - line.x_min) / (line.num_points - 1)
+                       : 0;
+
+        for (size_t i = 0; i < run.num_points; i++) {
+            float x = line.x_min + x_step * (run.first_point + i);
+
+            // Horner's method
+            float y = 0;
+            for (int c = (int) line.coefficients.size() - 1; c >= 0; c--) {
+                y = y * x + line.coefficients[c];
+            }
+
+            writePoint(output + i * POINT_STEP,
+                       x + noise_x(rng),
+                       y + noise_y(rng),
+                       0,
+                       LINE_RGB);
+        }
+    } else if (run.type == Run::CONE) {
+        const Cone& cone = _cones[run.element];
+        std::uniform_real_distribution<float> uniform(0, 1);
+
+        for (size_t i = 0; i < run.num_points; i++) {
+            // the surface area within s of the tip grows with s^2, so taking
+            // the square root spreads the points evenly over the surface
+            float s     = std::sqrt(uniform(rng));
+            float angle = 2 * M_PI * uniform(rng);
+            float r     = cone.radius * s;
+
+            writePoint(output + i * POINT_STEP,
+                       cone.x + r * std::cos(angle),
+                       cone.y + r * std::sin(angle),
+                       cone.height * (1 - s),
+                       CONE_RGB);
+        }
+    } else {
+        const Clutter& clutter = _clutter[run.element];
+        std::normal_distribution<float> normal(0, 1);
+
+        for (size_t i = 0; i < run.num_points; i++) {
+            float x = clutter.x + clutter.stddev * normal(rng);
+            float y = clutter.y + clutter.stddev * normal(rng);
+            float z = clutter.stddev_z * normal(rng);
+
+            writePoint(output + i * POINT_STEP, x, y, z, CLUTTER_RGB);
+        }
+    }
+}
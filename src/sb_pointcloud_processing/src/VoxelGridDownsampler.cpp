@@ -0,0 +1,98 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Class implementation for VoxelGridDownsampler
+ */
+
+#include "VoxelGridDownsampler.h"
+#include <cmath>
+
+VoxelGridDownsampler::VoxelGridDownsampler(float leaf_size,
+                                           bool use_z,
+                                           unsigned int max_points)
+  : _leaf_size(leaf_size), _use_z(use_z), _max_points(max_points) {}
+
+void VoxelGridDownsampler::downsample(const PointCloudView& input,
+                                      pcl::PointCloud<pcl::PointXYZ>& output) {
+    output.clear();
+    _cells.clear();
+    _cell_index.clear();
+
+    size_t size = input.size();
+
+    if (_leaf_size > 0) {
+        for (size_t i = 0; i < size; i++) {
+            float x = input.x(i), y = input.y(i), z = input.z(i);
+            if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
+                continue;
+
+            std::pair<std::unordered_map<uint64_t, unsigned int>::iterator,
+                      bool>
+            inserted = _cell_index.insert(
+            std::make_pair(cellKey(x, y, z), (unsigned int) _cells.size()));
+            if (inserted.second) {
+                Cell cell = {x, y, z, 1};
+                _cells.push_back(cell);
+            } else {
+                Cell& cell = _cells[inserted.first->second];
+                cell.x += x;
+                cell.y += y;
+                cell.z += z;
+                cell.count++;
+            }
+        }
+    } else {
+        // No binning, every finite point is its own cell
+        _cells.reserve(size);
+        for (size_t i = 0; i < size; i++) {
+            float x = input.x(i), y = input.y(i), z = input.z(i);
+            if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
+                continue;
+            Cell cell = {x, y, z, 1};
+            _cells.push_back(cell);
+        }
+    }
+
+    unsigned int count                                = _cells.size();
+    if (_max_points > 0 && count > _max_points) count = _max_points;
+
+    takeEvenlySpaced(_cells, count, output);
+}
+
+void VoxelGridDownsampler::takeEvenlySpaced(
+const std::vector<Cell>& cells,
+unsigned int count,
+pcl::PointCloud<pcl::PointXYZ>& output) const {
+    output.reserve(count);
+
+    for (unsigned int k = 0; k < count; k++) {
+        const Cell& cell = cells[(uint64_t) k * cells.size() / count];
+        pcl::PointXYZ point;
+        point.x = cell.x / cell.count;
+        point.y = cell.y / cell.count;
+        point.z = cell.z / cell.count;
+        output.push_back(point);
+    }
+}
+
+uint64_t VoxelGridDownsampler::cellKey(float x, float y, float z) const {
+    const uint64_t mask = (1 << 21) - 1;
+
+    uint64_t cx = (int64_t) std::floor(x / _leaf_size) & mask;
+    uint64_t cy = (int64_t) std::floor(y / _leaf_size) & mask;
+    uint64_t cz = _use_z ? (int64_t) std::floor(z / _leaf_size) & mask : 0;
+
+    return (cx << 42) | (cy << 21) | cz;
+}
+
+void VoxelGridDownsampler::setLeafSize(float leaf_size) {
+    _leaf_size = leaf_size;
+}
+
+void VoxelGridDownsampler::setUseZ(bool use_z) {
+    _use_z = use_z;
+}
+
+void VoxelGridDownsampler::setMaxPoints(unsigned int max_points) {
+    _max_points = max_points;
+}
@@ -0,0 +1,85 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Records the pointclouds published on "input" to a
+ *              CloudRecording file, so they can be replayed offline by
+ *              line_extractor_benchmark
+ *
+ *              rosrun sb_pointcloud_processing cloud_capture_node
+ *                  input:=/input_pointcloud _output_file:=course.sbcloud
+ */
+
+#include <CloudRecording.h>
+#include <ros/ros.h>
+#include <sb_utils.h>
+
+class CloudCapture {
+    ros::Subscriber subscriber;
+    CloudRecordingWriter writer;
+
+    // stop recording after this many frames, 0 records until shutdown
+    int max_frames;
+
+  public:
+    CloudCapture(ros::NodeHandle& nh, ros::NodeHandle& private_nh) {
+        std::string output_file;
+        if (!SB_getParam(private_nh, "output_file", output_file)) {
+            ROS_ERROR("~output_file must be set to the recording to write");
+            ros::shutdown();
+            return;
+        }
+        SB_getParam(private_nh, "max_frames", max_frames, 0);
+
+        if (!writer.open(output_file)) {
+            ROS_ERROR_STREAM("Could not open " << output_file);
+            ros::shutdown();
+            return;
+        }
+
+        // every frame is needed, so queue up rather than drop clouds while a
+        // frame is being written
+        uint32_t queue_size = 100;
+        subscriber =
+        nh.subscribe("input", queue_size, &CloudCapture::pclCallBack, this);
+
+        ROS_INFO_STREAM("Recording " << nh.resolveName("input") << " to "
+                                     << output_file);
+    }
+
+    ~CloudCapture() {
+        size_t num_frames = writer.numFrames();
+        if (writer.isOpen() && !writer.close()) {
+            ROS_ERROR("Could not finish writing the recording");
+            return;
+        }
+        ROS_INFO_STREAM("Recorded " << num_frames << " frames");
+    }
+
+  private:
+    void pclCallBack(const sensor_msgs::PointCloud2ConstPtr cloud) {
+        if (!writer.isOpen()) { return; }
+
+        if (!writer.append(*cloud)) {
+            ROS_WARN_THROTTLE(5, "Could not record pointcloud");
+            return;
+        }
+
+        if (max_frames > 0 && writer.numFrames() >= (size_t) max_frames) {
+            subscriber.shutdown();
+            ros::shutdown();
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    std::string node_name = "cloud_capture_node";
+    ros::init(argc, argv, node_name);
+    ros::NodeHandle nh;
+    ros::NodeHandle private_nh("~");
+
+    CloudCapture capture(nh, private_nh);
+
+    ros::spin();
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which estimates the ground plane of a pointcloud
+ *              and keeps only the points within a band around it.
+ */
+
+#include <ground_plane_filter.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_pointcloud_processing;
+
+GroundPlaneFilter::GroundPlaneFilter() {}
+
+void GroundPlaneFilter::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    ros::NodeHandle& private_nh = getPrivateNodeHandle();
+
+    SB_getParam(private_nh, "output_frame", output_frame, std::string(""));
+    if (!output_frame.empty()) {
+        tf_listener.reset(new tf2_ros::TransformListener(tf_buffer));
+    }
+
+    double inlier_threshold, max_tilt, time_budget_ms, min_inlier_ratio;
+    double min_distance, max_distance;
+    int max_samples, max_iterations, seed;
+    SB_getParam(private_nh, "inlier_threshold", inlier_threshold, 0.03);
+    SB_getParam(private_nh, "max_tilt", max_tilt, 0.35);
+    SB_getParam(private_nh, "max_samples", max_samples, 500);
+    SB_getParam(private_nh, "max_iterations", max_iterations, 100);
+    SB_getParam(private_nh, "time_budget_ms", time_budget_ms, 2.0);
+    SB_getParam(private_nh, "min_inlier_ratio", min_inlier_ratio, 0.2);
+    SB_getParam(private_nh, "min_distance", min_distance, -0.05);
+    SB_getParam(private_nh, "max_distance", max_distance, 0.2);
+    SB_getParam(private_nh, "seed", seed, 123);
+    SB_getParam(
+    private_nh, "separate_plane_input", separate_plane_input, false);
+
+    segmenter.reset(new GroundPlaneSegmenter(inlier_threshold,
+                                             max_tilt,
+                                             std::max(max_samples, 3),
+                                             std::max(max_iterations, 1),
+                                             time_budget_ms,
+                                             seed));
+    segmenter->setMinInlierRatio(min_inlier_ratio);
+    segmenter->setBand(min_distance, max_distance);
+
+    sub = private_nh.subscribe("input", 1, &GroundPlaneFilter::callback, this);
+    if (separate_plane_input) {
+        plane_sub = private_nh.subscribe(
+        "plane_input", 1, &GroundPlaneFilter::planeCallback, this);
+    }
+    pub = private_nh.advertise<sensor_msgs::PointCloud2>("output", 1);
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+bool GroundPlaneFilter::lookupTransform(const std_msgs::Header& header,
+                                        Eigen::Affine3f& transform,
+                                        bool& transformed) {
+    transformed = !output_frame.empty() && output_frame != header.frame_id;
+    if (!transformed) { return true; }
+
+    geometry_msgs::TransformStamped transform_msg;
+    try {
+        transform_msg = tf_buffer.lookupTransform(
+        output_frame, header.frame_id, header.stamp, ros::Duration(0.1));
+    } catch (tf2::TransformException& ex) {
+        NODELET_WARN_STREAM("Could not transform pointcloud to " << output_frame
+                                                                 << ": "
+                                                                 << ex.what());
+        return false;
+    }
+
+    const geometry_msgs::Vector3& t    = transform_msg.transform.translation;
+    const geometry_msgs::Quaternion& q = transform_msg.transform.rotation;
+    transform                          = Eigen::Translation3f(t.x, t.y, t.z) *
+                Eigen::Quaternionf(q.w, q.x, q.y, q.z);
+    return true;
+}
+
+void GroundPlaneFilter::planeCallback(
+const sensor_msgs::PointCloud2::ConstPtr& input) {
+    Eigen::Affine3f transform;
+    bool transformed;
+    if (!lookupTransform(input->header, transform, transformed)) { return; }
+
+    boost::mutex::scoped_lock lock(mutex);
+    if (transformed) {
+        segmenter->setTransform(transform);
+    } else {
+        segmenter->clearTransform();
+    }
+
+    if (!segmenter->updatePlane(*input)) {
+        NODELET_WARN_THROTTLE(
+        5, "Pointcloud needs x, y and z fields to estimate the plane from");
+    }
+}
+
+void GroundPlaneFilter::callback(
+const sensor_msgs::PointCloud2::ConstPtr& input) {
+    // Published as a shared pointer so nodelets in the same manager
+    // receive it without a copy. The last message's buffers are reused
+    // once nothing else holds on to it.
+    if (!output || !output.unique()) {
+        output.reset(new sensor_msgs::PointCloud2());
+    }
+
+    Eigen::Affine3f transform;
+    bool transformed;
+    if (!lookupTransform(input->header, transform, transformed)) { return; }
+
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        if (transformed) {
+            segmenter->setTransform(transform);
+        } else {
+            segmenter->clearTransform();
+        }
+
+        // The plane from ~plane_input is the latest one estimated, which at
+        // worst is the one of the previous cloud
+        bool segmented = separate_plane_input
+                         ? segmenter->filter(*input, *output)
+                         : segmenter->segment(*input, *output);
+        if (!segmented) {
+            NODELET_WARN_THROTTLE(
+            5, "Pointcloud needs x, y and z fields to be filtered");
+            return;
+        }
+    }
+    if (!output_frame.empty()) { output->header.frame_id = output_frame; }
+
+    pub.publish(output);
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(GroundPlaneFilter, nodelet::Nodelet)
@@ -0,0 +1,101 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which takes a pointcloud in the RGB colourspace
+ *              and keeps only the points within hue, saturation, value and
+ *              height limits.
+ */
+
+#include <hsv_height_filter.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_pointcloud_processing;
+
+HSVHeightFilter::HSVHeightFilter() {}
+
+void HSVHeightFilter::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    ros::NodeHandle& private_nh = getPrivateNodeHandle();
+
+    private_nh.param<std::string>("output_frame", output_frame, "");
+    if (!output_frame.empty()) {
+        tf_listener.reset(new tf2_ros::TransformListener(tf_buffer));
+    }
+
+    // The server loads the initial limits from the param server
+    reconfigure_server.reset(
+    new dynamic_reconfigure::Server<HSVHeightFilterConfig>(private_nh));
+    reconfigure_server->setCallback(
+    boost::bind(&HSVHeightFilter::reconfigureCallback, this, _1, _2));
+
+    sub = private_nh.subscribe("input", 1, &HSVHeightFilter::callback, this);
+    pub = private_nh.advertise<sensor_msgs::PointCloud2>("output", 1);
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+void HSVHeightFilter::reconfigureCallback(HSVHeightFilterConfig& config,
+                                          uint32_t level) {
+    boost::mutex::scoped_lock lock(mutex);
+    filter.setHueLimits(config.h_min, config.h_max);
+    filter.setSaturationLimits(config.s_min, config.s_max);
+    filter.setValueLimits(config.v_min, config.v_max);
+    filter.setHeightLimits(config.z_min, config.z_max);
+}
+
+void HSVHeightFilter::callback(
+const sensor_msgs::PointCloud2::ConstPtr& input) {
+    bool transform_input =
+    !output_frame.empty() && output_frame != input->header.frame_id;
+
+    Eigen::Affine3f transform = Eigen::Affine3f::Identity();
+    if (transform_input) {
+        geometry_msgs::TransformStamped transform_msg;
+        try {
+            transform_msg = tf_buffer.lookupTransform(output_frame,
+                                                      input->header.frame_id,
+                                                      input->header.stamp,
+                                                      ros::Duration(0.1));
+        } catch (tf2::TransformException& ex) {
+            NODELET_WARN_STREAM(
+            "Could not transform pointcloud to " << output_frame << ": "
+                                                 << ex.what());
+            return;
+        }
+
+        const geometry_msgs::Vector3& t = transform_msg.transform.translation;
+        const geometry_msgs::Quaternion& q = transform_msg.transform.rotation;
+        transform = Eigen::Translation3f(t.x, t.y, t.z) *
+                    Eigen::Quaternionf(q.w, q.x, q.y, q.z);
+    }
+
+    // Published as a shared pointer so nodelets in the same manager
+    // receive it without a copy. The last message's buffers are reused
+    // once nothing else holds on to it, as in sb_vision's
+    // ImageMessageBuffer.
+    if (!output || !output.unique()) {
+        output.reset(new sensor_msgs::PointCloud2());
+    }
+    {
+        boost::mutex::scoped_lock lock(mutex);
+
+        if (transform_input) {
+            filter.setTransform(transform);
+        } else {
+            filter.clearTransform();
+        }
+
+        if (!filter.filter(*input, *output)) {
+            NODELET_WARN_THROTTLE(
+            5,
+            "Pointcloud needs x, y, z and rgb fields within its data to be "
+            "filtered");
+            return;
+        }
+    }
+    if (transform_input) { output->header.frame_id = output_frame; }
+
+    pub.publish(output);
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(HSVHeightFilter, nodelet::Nodelet)
@@ -0,0 +1,168 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Pushes every frame of a CloudRecording through the line
+ *              extractor's DBSCAN and Regression as fast as possible, and
+ *              reports the latency of each stage and the frames per second.
+ *              Doesn't need ROS to be running.
+ *
+ *              line_extractor_benchmark course.sbcloud [--min_neighbours 60]
+ *                  [--radius 0.05] [--degree_polynomial 3] [--lambda 0]
+ *                  [--voxel_size 0] [--voxel_use_z 0] [--max_points 0]
+ *                  [--repeat 1]
+ */
+
+#include <CloudRecording.h>
+#include <DBSCAN.h>
+#include <Regression.h>
+#include <VoxelGridDownsampler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+/*
+ * Prints the latency percentiles of a stage, in milliseconds
+ */
+static void printStage(const char* name, std::vector<double> latencies) {
+    if (latencies.empty()) { return; }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1,
+                                  (size_t)(p * latencies.size()))];
+    };
+    double total = 0;
+    for (double latency : latencies) { total += latency; }
+
+    std::printf("%-12s %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                name,
+                total / latencies.size(),
+                percentile(0.5),
+                percentile(0.9),
+                percentile(0.99),
+                latencies.back());
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc % 2 != 0) {
+        std::fprintf(stderr,
+                     "usage: %s <recording> [--param value]...\n"
+                     "params: min_neighbours radius degree_polynomial lambda "
+                     "voxel_size voxel_use_z max_points repeat\n",
+                     argv[0]);
+        return 1;
+    }
+
+    // same defaults as launch/line_extractor.launch
+    std::map<std::string, double> params = {{"min_neighbours", 60},
+                                            {"radius", 0.05},
+                                            {"degree_polynomial", 3},
+                                            {"lambda", 0},
+                                            {"voxel_size", 0},
+                                            {"voxel_use_z", 0},
+                                            {"max_points", 0},
+                                            {"repeat", 1}};
+    for (int i = 2; i < argc; i += 2) {
+        std::string name = argv[i];
+        if (name.compare(0, 2, "--") != 0 || !params.count(name.substr(2))) {
+            std::fprintf(stderr, "unknown param %s\n", argv[i]);
+            return 1;
+        }
+        params[name.substr(2)] = std::atof(argv[i + 1]);
+    }
+
+    CloudRecording recording;
+    if (!recording.open(argv[1])) {
+        std::fprintf(stderr, "could not read recording %s\n", argv[1]);
+        return 1;
+    }
+    if (recording.numFrames() == 0) {
+        std::fprintf(stderr, "%s has no frames\n", argv[1]);
+        return 1;
+    }
+
+    DBSCAN dbscan(params["min_neighbours"], params["radius"]);
+    unsigned int degree_polynomial = params["degree_polynomial"];
+    float lambda                   = params["lambda"];
+    bool downsample = params["voxel_size"] > 0 || params["max_points"] > 0;
+    VoxelGridDownsampler downsampler(
+    params["voxel_size"], params["voxel_use_z"] != 0, params["max_points"]);
+    pcl::PointCloud<pcl::PointXYZ> downsampled;
+    int repeat = std::max(1, (int) params["repeat"]);
+
+    // fault the whole recording in, so reading it from disk isn't timed
+    volatile float checksum = 0;
+    for (size_t f = 0; f < recording.numFrames(); f++) {
+        CloudRecording::Frame frame = recording.frame(f);
+        for (size_t i = 0; i < frame.num_points * 3; i += 1024) {
+            checksum = checksum + frame.xyz[i];
+        }
+    }
+
+    std::vector<double> downsample_latencies, dbscan_latencies,
+    regression_latencies, total_latencies;
+    size_t num_points = 0, num_lines = 0;
+
+    Clock::time_point run_start = Clock::now();
+    for (int r = 0; r < repeat; r++) {
+        for (size_t f = 0; f < recording.numFrames(); f++) {
+            Clock::time_point frame_start = Clock::now();
+            PointCloudView view           = recording.frame(f).view();
+            num_points += view.size();
+
+            if (downsample) {
+                Clock::time_point start = Clock::now();
+                downsampler.downsample(view, downsampled);
+                view = PointCloudView(downsampled);
+                downsample_latencies.push_back(millisecondsSince(start));
+            }
+
+            Clock::time_point start = Clock::now();
+            std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters =
+            dbscan.findClusters(view);
+            dbscan_latencies.push_back(millisecondsSince(start));
+
+            start = Clock::now();
+            std::vector<Eigen::VectorXf> lines =
+            Regression::getLinesOfBestFit(clusters, degree_polynomial, lambda);
+            regression_latencies.push_back(millisecondsSince(start));
+            num_lines += lines.size();
+
+            total_latencies.push_back(millisecondsSince(frame_start));
+        }
+    }
+    double run_time = millisecondsSince(run_start) / 1000;
+    size_t num_runs = total_latencies.size();
+
+    std::printf("%zu frames x %d, %.1f points and %.2f lines per frame\n",
+                recording.numFrames(),
+                repeat,
+                (double) num_points / num_runs,
+                (double) num_lines / num_runs);
+    std::printf("%-12s %9s %9s %9s %9s %9s\n",
+                "stage (ms)",
+                "mean",
+                "p50",
+                "p90",
+                "p99",
+                "max");
+    printStage("downsample", downsample_latencies);
+    printStage("dbscan", dbscan_latencies);
+    printStage("regression", regression_latencies);
+    printStage("total", total_latencies);
+    std::printf("%.1f frames per second\n", num_runs / run_time);
+
+    return 0;
+}
@@ -9,9 +9,13 @@
 int main(int argc, char** argv) {
     // Set up ROS node
     std::string node_name = "line_extractor_node";
+    ros::init(argc, argv, node_name);
+    ros::NodeHandle nh;
+    ros::NodeHandle private_nh("~");
 
     // Create an instance of the class
-    LineExtractorNode node(argc, argv, node_name);
+    LineExtractorNode node(nh, private_nh);
+    if (!node.isValid()) { return 1; }
 
     // Start up
     ros::spin();
@@ -0,0 +1,22 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which extracts line obstacles from a pointcloud.
+ */
+
+#include <line_extractor_nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_pointcloud_processing;
+
+LineExtractorNodelet::LineExtractorNodelet() {}
+
+void LineExtractorNodelet::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    line_extractor.reset(
+    new LineExtractorNode(getNodeHandle(), getPrivateNodeHandle()));
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(LineExtractorNodelet, nodelet::Nodelet)
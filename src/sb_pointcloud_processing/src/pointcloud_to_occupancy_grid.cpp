@@ -0,0 +1,123 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: A ros nodelet which projects a filtered pointcloud onto an
+ *              occupancy grid centred on the robot.
+ */
+
+#include <pluginlib/class_list_macros.h>
+#include <pointcloud_to_occupancy_grid.h>
+
+using namespace sb_pointcloud_processing;
+
+PointCloudToOccupancyGrid::PointCloudToOccupancyGrid() {}
+
+void PointCloudToOccupancyGrid::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    ros::NodeHandle& private_nh = getPrivateNodeHandle();
+
+    SB_getParam(private_nh, "grid_frame", grid_frame, std::string("odom"));
+    SB_getParam(private_nh, "base_frame", base_frame, std::string("base_link"));
+
+    int width, height, unknown_value;
+    double resolution;
+    SB_getParam(private_nh, "width", width, 200);
+    SB_getParam(private_nh, "height", height, 200);
+    SB_getParam(private_nh, "resolution", resolution, 0.05);
+    SB_getParam(private_nh,
+                "unknown_value",
+                unknown_value,
+                (int) OccupancyGridProjector::GRID_FREE);
+    if (width <= 0 || height <= 0 || resolution <= 0) {
+        NODELET_ERROR("width, height and resolution must be positive");
+        return;
+    }
+    // Occupancy grid cells hold -1 (unknown) or a probability from 0 to 100
+    if (unknown_value < -1 || unknown_value > 100) {
+        NODELET_ERROR("unknown_value must be between -1 and 100");
+        return;
+    }
+    projector =
+    OccupancyGridProjector(width, height, resolution, unknown_value);
+
+    tf_listener.reset(new tf2_ros::TransformListener(tf_buffer));
+
+    sub = private_nh.subscribe(
+    "input", 1, &PointCloudToOccupancyGrid::callback, this);
+    pub = private_nh.advertise<nav_msgs::OccupancyGrid>("output", 1);
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+void PointCloudToOccupancyGrid::callback(
+const sensor_msgs::PointCloud2::ConstPtr& input) {
+    PointCloudView cloud(*input);
+    if (cloud.empty() && input->width * input->height > 0) {
+        NODELET_WARN_THROTTLE(5, "Pointcloud needs float x and y fields");
+        return;
+    }
+
+    Eigen::Affine3f cloud_to_grid, base_to_grid;
+    if (!lookupTransform(
+        input->header.frame_id, input->header.stamp, cloud_to_grid) ||
+        !lookupTransform(base_frame, input->header.stamp, base_to_grid)) {
+        return;
+    }
+
+    // Centre the grid on the robot, snapped to whole cells so obstacles
+    // don't jitter between cells as the robot moves
+    float resolution = projector.resolution();
+    Eigen::Vector2f grid_origin(
+    std::floor(base_to_grid.translation().x() / resolution) -
+    projector.width() / 2,
+    std::floor(base_to_grid.translation().y() / resolution) -
+    projector.height() / 2);
+    grid_origin *= resolution;
+    Eigen::Vector2f sensor_origin = cloud_to_grid.translation().head<2>();
+
+    // Published as a shared pointer so nodelets in the same manager
+    // receive it without a copy. The last grid's cells are reused once
+    // nothing else holds on to it.
+    if (!grid || !grid.unique()) {
+        grid.reset(new nav_msgs::OccupancyGrid());
+        grid->header.frame_id           = grid_frame;
+        grid->info.width                = projector.width();
+        grid->info.height               = projector.height();
+        grid->info.resolution           = resolution;
+        grid->info.origin.orientation.w = 1;
+    }
+
+    projector.project(
+    cloud, cloud_to_grid, grid_origin, sensor_origin, grid->data);
+
+    grid->header.stamp           = input->header.stamp;
+    grid->info.map_load_time     = input->header.stamp;
+    grid->info.origin.position.x = grid_origin.x();
+    grid->info.origin.position.y = grid_origin.y();
+
+    pub.publish(grid);
+}
+
+bool PointCloudToOccupancyGrid::lookupTransform(const std::string& source_frame,
+                                                const ros::Time& stamp,
+                                                Eigen::Affine3f& transform) {
+    geometry_msgs::TransformStamped transform_msg;
+    try {
+        transform_msg = tf_buffer.lookupTransform(
+        grid_frame, source_frame, stamp, ros::Duration(0.1));
+    } catch (tf2::TransformException& ex) {
+        NODELET_WARN_STREAM_THROTTLE(
+        5,
+        "Could not transform " << source_frame << " to " << grid_frame << ": "
+                               << ex.what());
+        return false;
+    }
+
+    const geometry_msgs::Vector3& t    = transform_msg.transform.translation;
+    const geometry_msgs::Quaternion& q = transform_msg.transform.rotation;
+    transform                          = Eigen::Translation3f(t.x, t.y, t.z) *
+                Eigen::Quaternionf(q.w, q.x, q.y, q.z);
+    return true;
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(PointCloudToOccupancyGrid, nodelet::Nodelet)
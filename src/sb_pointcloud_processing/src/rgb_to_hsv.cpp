@@ -36,7 +36,7 @@ void RGBtoHSV::callback(const sensor_msgs::PointCloud2::ConstPtr& input) {
     converter.setInputCloud(pcl_rgb);
     pcl::PointCloud<PointXYZHSV>::Ptr pcl_output(
     new pcl::PointCloud<PointXYZHSV>());
-    converter.convert(*pcl_output);
+    converter.convertBatch(*pcl_output);
 
     // Publishes the new cloud
     pub.publish(*pcl_output);
@@ -2,69 +2,59 @@
  * Created by: Min Gyo Kim
  * Created On: March 11th 2018
  * Description: Generates a point cloud with two lines and an optional outlier
- * line and publishes it to "/input/pointcloud"
+ * line and publishes it to "/input/pointcloud". It can also add any number of
+ * random lines, cones and gaussian clutter, at any rate, to load test the
+ * pointcloud pipeline.
  */
 
+#include <SyntheticCloudGenerator.h>
 #include <TestUtils.h>
-#include <pcl/point_cloud.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <ros/ros.h>
 #include <sb_utils.h>
 #include <sensor_msgs/PointCloud2.h>
 
-std::vector<float> first_line;
-std::vector<float> second_line;
-
-float x_min;
-float x_max;
-float x_delta;
-float max_noise_x;
-float max_noise_y;
-
-float outlier_x_delta;
-std::vector<float> outlier_line;
-
-sensor_msgs::PointCloud2 generatePclMessage(bool include_outlier);
-unsigned int getSeed();
-
-unsigned int counter = 0;
-
 int main(int argc, char** argv) {
     ros::init(argc, argv, "test_pcl_generator_node");
     ros::NodeHandle nh;
     ros::NodeHandle private_nh("~");
 
-    ros::Rate loop_rate = 0.75;
     ros::Publisher publisher =
     nh.advertise<sensor_msgs::PointCloud2>("input_pointcloud", 1);
 
     std::string first_line_param          = "first_line";
     std::vector<float> default_first_line = {50, 0, -0.01};
+    std::vector<float> first_line;
     private_nh.param(first_line_param, first_line, default_first_line);
 
     std::string second_line_param          = "second_line";
     std::vector<float> default_second_line = {0, 0, -0.01};
+    std::vector<float> second_line;
     private_nh.param(second_line_param, second_line, default_second_line);
 
     std::string x_min_param = "x_min";
     float default_x_min     = -5;
+    float x_min;
     SB_getParam(private_nh, x_min_param, x_min, default_x_min);
 
     std::string x_max_param = "x_max";
     float default_x_max     = 5;
+    float x_max;
     SB_getParam(private_nh, x_max_param, x_max, default_x_max);
 
     std::string x_delta_param = "x_delta";
     float default_x_delta     = 0.01;
+    float x_delta;
     SB_getParam(private_nh, x_delta_param, x_delta, default_x_delta);
 
     std::string max_noise_x_param = "max_noise_x";
     float default_max_noise_x     = 5;
+    float max_noise_x;
     SB_getParam(
     private_nh, max_noise_x_param, max_noise_x, default_max_noise_x);
 
     std::string max_noise_y_param = "max_noise_y";
     float default_max_noise_y     = 5;
+    float max_noise_y;
     SB_getParam(
     private_nh, max_noise_y_param, max_noise_y, default_max_noise_y);
 
@@ -78,65 +68,232 @@ int main(int argc, char** argv) {
     std::string frame_id;
     SB_getParam(private_nh, frame_id_param, frame_id, default_frame_id);
 
+    // load generation
+    std::string rate_param = "rate";
+    double default_rate    = 0.75;
+    double rate;
+    SB_getParam(private_nh, rate_param, rate, default_rate);
+
+    std::string seed_param = "seed";
+    int default_seed       = 123;
+    int seed;
+    SB_getParam(private_nh, seed_param, seed, default_seed);
+
+    // points on each of the first and second lines, 0 spaces them x_delta
+    // apart instead
+    std::string points_per_line_param = "points_per_line";
+    int default_points_per_line       = 0;
+    int points_per_line;
+    SB_getParam(private_nh,
+                points_per_line_param,
+                points_per_line,
+                default_points_per_line);
+
+    std::string num_random_lines_param = "num_random_lines";
+    int default_num_random_lines       = 0;
+    int num_random_lines;
+    SB_getParam(private_nh,
+                num_random_lines_param,
+                num_random_lines,
+                default_num_random_lines);
+
+    std::string random_line_degree_param = "random_line_degree";
+    int default_random_line_degree       = 3;
+    int random_line_degree;
+    SB_getParam(private_nh,
+                random_line_degree_param,
+                random_line_degree,
+                default_random_line_degree);
+
+    std::string random_line_points_param = "random_line_points";
+    int default_random_line_points       = 1000;
+    int random_line_points;
+    SB_getParam(private_nh,
+                random_line_points_param,
+                random_line_points,
+                default_random_line_points);
+
+    std::string random_line_noise_param = "random_line_noise";
+    float default_random_line_noise     = 0.05;
+    float random_line_noise;
+    SB_getParam(private_nh,
+                random_line_noise_param,
+                random_line_noise,
+                default_random_line_noise);
+
+    // random lines and cones are placed within [-y_range, y_range]
+    std::string y_range_param = "y_range";
+    float default_y_range     = 5;
+    float y_range;
+    SB_getParam(private_nh, y_range_param, y_range, default_y_range);
+
+    std::string num_cones_param = "num_cones";
+    int default_num_cones       = 0;
+    int num_cones;
+    SB_getParam(private_nh, num_cones_param, num_cones, default_num_cones);
+
+    std::string cone_points_param = "cone_points";
+    int default_cone_points       = 200;
+    int cone_points;
+    SB_getParam(
+    private_nh, cone_points_param, cone_points, default_cone_points);
+
+    std::string cone_radius_param = "cone_radius";
+    float default_cone_radius     = 0.15;
+    float cone_radius;
+    SB_getParam(
+    private_nh, cone_radius_param, cone_radius, default_cone_radius);
+
+    std::string cone_height_param = "cone_height";
+    float default_cone_height     = 0.45;
+    float cone_height;
+    SB_getParam(
+    private_nh, cone_height_param, cone_height, default_cone_height);
+
+    std::string clutter_points_param = "clutter_points";
+    int default_clutter_points       = 0;
+    int clutter_points;
+    SB_getParam(
+    private_nh, clutter_points_param, clutter_points, default_clutter_points);
+
+    std::string clutter_stddev_param = "clutter_stddev";
+    float default_clutter_stddev     = 2;
+    float clutter_stddev;
+    SB_getParam(
+    private_nh, clutter_stddev_param, clutter_stddev, default_clutter_stddev);
+
+    std::string clutter_stddev_z_param = "clutter_stddev_z";
+    float default_clutter_stddev_z     = 0;
+    float clutter_stddev_z;
+    SB_getParam(private_nh,
+                clutter_stddev_z_param,
+                clutter_stddev_z,
+                default_clutter_stddev_z);
+
+    // points per row of an organised cloud, 0 publishes an unorganised cloud
+    std::string organised_width_param = "organised_width";
+    int default_organised_width       = 0;
+    int organised_width;
+    SB_getParam(private_nh,
+                organised_width_param,
+                organised_width,
+                default_organised_width);
+
+    // regenerating large clouds can take longer than a frame, in which case
+    // the first cloud can be republished instead to reach the rate
+    std::string regenerate_param = "regenerate";
+    bool default_regenerate      = true;
+    bool regenerate;
+    SB_getParam(private_nh, regenerate_param, regenerate, default_regenerate);
+
+    if (rate <= 0 || x_delta <= 0 || points_per_line < 0 ||
+        num_random_lines < 0 || random_line_degree < 0 ||
+        random_line_points < 0 || num_cones < 0 || cone_points < 0 ||
+        clutter_points < 0 || organised_width < 0) {
+        ROS_ERROR(
+        "Bad parameters, rates, counts and x_delta can't be negative");
+        return 1;
+    }
+
+    SyntheticCloudGenerator generator(seed);
+
+    unsigned int num_line_points =
+    points_per_line > 0
+    ? points_per_line
+    : LineExtractor::TestUtils::getNumPoints(
+      LineExtractor::TestUtils::LineArgs({}, x_min, x_max, x_delta));
+    for (const std::vector<float>& coefficients : {first_line, second_line}) {
+        generator.addLine({coefficients,
+                           x_min,
+                           x_max,
+                           num_line_points,
+                           max_noise_x,
+                           max_noise_y});
+    }
+
     if (outlier) {
         std::string outlier_line_param          = "outlier_line";
         std::vector<float> default_outlier_line = {0};
+        std::vector<float> outlier_line;
         private_nh.param(
         outlier_line_param, outlier_line, default_outlier_line);
 
         std::string outlier_x_delta_param = "outlier_x_delta";
         float default_outlier_x_delta     = 1;
+        float outlier_x_delta;
         private_nh.param(
         outlier_x_delta_param, outlier_x_delta, default_outlier_x_delta);
-    }
 
-    while (ros::ok()) {
-        sensor_msgs::PointCloud2 msg_to_publish = generatePclMessage(outlier);
-        msg_to_publish.header.frame_id          = frame_id;
-
-        publisher.publish(msg_to_publish);
+        unsigned int num_outlier_points =
+        LineExtractor::TestUtils::getNumPoints(
+        LineExtractor::TestUtils::LineArgs(
+        outlier_line, x_min, x_max, outlier_x_delta));
+        generator.addLine({outlier_line,
+                           x_min,
+                           x_max,
+                           num_outlier_points,
+                           max_noise_x,
+                           max_noise_y});
+    }
 
-        ros::spinOnce();
-        loop_rate.sleep();
+    generator.addRandomLines(num_random_lines,
+                             random_line_degree,
+                             x_min,
+                             x_max,
+                             y_range,
+                             random_line_points,
+                             random_line_noise);
+    generator.addRandomCones(
+    num_cones, x_min, x_max, y_range, cone_radius, cone_height, cone_points);
+    if (clutter_points > 0) {
+        generator.addClutter({0,
+                              0,
+                              clutter_stddev,
+                              clutter_stddev_z,
+                              (unsigned int) clutter_points});
     }
-}
+    generator.setOrganisedWidth(organised_width);
 
-sensor_msgs::PointCloud2 generatePclMessage(bool include_outlier) {
-    // coefficients is the same as the one in LineObstacle message
-    LineExtractor::TestUtils::LineArgs args(first_line, x_min, x_max, x_delta);
+    ROS_INFO_STREAM(
+    "Publishing " << generator.numPoints() << " points at " << rate << " Hz");
 
-    // Generate a single PointCloud with noise
-    pcl::PointCloud<pcl::PointXYZ> pcl;
-    LineExtractor::TestUtils::addLineToPointCloud(
-    args, pcl, max_noise_x, max_noise_y, getSeed());
+    // the message is reused every frame, so its buffer is only allocated once
+    sensor_msgs::PointCloud2 msg_to_publish;
+    msg_to_publish.header.frame_id = frame_id;
+    generator.generate(msg_to_publish);
 
-    // Add second line to the pointcloud
-    args.coefficients = second_line;
-    LineExtractor::TestUtils::addLineToPointCloud(
-    args, pcl, max_noise_x, max_noise_y, getSeed());
+    ros::Rate loop_rate = rate;
+    bool first_frame    = true;
 
-    // Add outlier if wanted
-    if (include_outlier) {
-        args.coefficients = outlier_line;
-        args.x_delta      = outlier_x_delta;
+    ros::WallTime last_report = ros::WallTime::now();
+    unsigned int frames       = 0;
+    double generation_time    = 0;
 
-        LineExtractor::TestUtils::addLineToPointCloud(
-        args, pcl, max_noise_x, max_noise_y, getSeed());
-    }
+    while (ros::ok()) {
+        if (regenerate && !first_frame) {
+            ros::WallTime start = ros::WallTime::now();
+            generator.generate(msg_to_publish);
+            generation_time += (ros::WallTime::now() - start).toSec();
+        }
+        first_frame                 = false;
+        msg_to_publish.header.stamp = ros::Time::now();
 
-    // convert pointcloud to sensor msgs
-    sensor_msgs::PointCloud2 msg;
-    pcl::toROSMsg(pcl, msg);
+        publisher.publish(msg_to_publish);
+        frames++;
 
-    return msg;
-}
+        // report the rate actually reached, to tell when the generator
+        // itself is the bottleneck
+        double elapsed = (ros::WallTime::now() - last_report).toSec();
+        if (elapsed >= 5) {
+            ROS_INFO("Published %.1f Hz, %.1f ms per frame generating",
+                     frames / elapsed,
+                     1000 * generation_time / frames);
+            last_report     = ros::WallTime::now();
+            frames          = 0;
+            generation_time = 0;
+        }
 
-/**
- * function that returns a seed;
- * the seed returned increments every time this function is called,
- * and once the seed reaches 9, the next seed resets to 0;
- * @return
- */
-unsigned int getSeed() {
-    return counter++ % 10;
+        ros::spinOnce();
+        loop_rate.sleep();
+    }
 }
@@ -6,6 +6,7 @@
 
 #include "./TestUtils.h"
 #include <DBSCAN.h>
+#include <cstring>
 #include <gtest/gtest.h>
 
 TEST(DBSCAN, ClusterTwoNearPoints) {
@@ -339,6 +340,80 @@ TEST(DBSCAN, TestClusterTwoPolynomialLinesWithNoise) {
     EXPECT_EQ(LineExtractor::TestUtils::getNumPoints(args), clusters[1].size());
 }
 
+// An organized 2x2 cloud with an extra field and padding at the end of each
+// row, holding two points near (1, 1) and two near (10, 10)
+static sensor_msgs::PointCloud2 makePaddedCloud() {
+    sensor_msgs::PointCloud2 msg;
+    msg.height     = 2;
+    msg.width      = 2;
+    msg.point_step = 16;
+    msg.row_step   = msg.width * msg.point_step + 8;
+
+    const char* names[] = {"x", "y", "z", "intensity"};
+    for (unsigned int i = 0; i < 4; i++) {
+        sensor_msgs::PointField field;
+        field.name     = names[i];
+        field.offset   = i * sizeof(float);
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count    = 1;
+        msg.fields.push_back(field);
+    }
+
+    float points[4][4] = {
+    {1, 1, 0, 7}, {10, 10, 0, 7}, {1.1, 1.1, 0, 7}, {10.1, 10.1, 0, 7}};
+    msg.data.resize(msg.height * msg.row_step);
+    for (unsigned int i = 0; i < 4; i++) {
+        unsigned int row = i / msg.width;
+        unsigned int col = i % msg.width;
+        std::memcpy(&msg.data[row * msg.row_step + col * msg.point_step],
+                    points[i],
+                    sizeof(points[i]));
+    }
+
+    return msg;
+}
+
+TEST(DBSCAN, ClusterPointsReadFromPointCloud2) {
+    int min_neighbours = 1;
+    float radius       = 0.5;
+    DBSCAN dbscan(min_neighbours, radius);
+
+    // The view has to skip over the extra field and the row padding
+    sensor_msgs::PointCloud2 msg = makePaddedCloud();
+    PointCloudView view(msg);
+    ASSERT_EQ(4, view.size());
+
+    vector<pcl::PointCloud<pcl::PointXYZ>> clusters = dbscan.findClusters(view);
+    ASSERT_EQ(2, clusters.size());
+    ASSERT_EQ(2, clusters[0].size());
+    ASSERT_EQ(2, clusters[1].size());
+
+    EXPECT_FLOAT_EQ(1, clusters[0][0].x);
+    EXPECT_FLOAT_EQ(1.1, clusters[0][1].y);
+    EXPECT_FLOAT_EQ(10, clusters[1][0].x);
+    EXPECT_FLOAT_EQ(10.1, clusters[1][1].y);
+}
+
+TEST(DBSCAN, MalformedPointCloud2GivesEmptyView) {
+    sensor_msgs::PointCloud2 msg = makePaddedCloud();
+    EXPECT_EQ(4, PointCloudView(msg).size());
+
+    sensor_msgs::PointCloud2 truncated = msg;
+    truncated.data.resize(msg.data.size() - 1);
+    EXPECT_TRUE(PointCloudView(truncated).empty());
+
+    sensor_msgs::PointCloud2 short_rows = msg;
+    short_rows.row_step                 = msg.width * msg.point_step - 1;
+    EXPECT_TRUE(PointCloudView(short_rows).empty());
+
+    sensor_msgs::PointCloud2 field_outside = msg;
+    field_outside.fields[2].offset         = msg.point_step - 2;
+    EXPECT_TRUE(PointCloudView(field_outside).empty());
+
+    DBSCAN dbscan(1, 0.5);
+    EXPECT_TRUE(dbscan.findClusters(PointCloudView(truncated)).empty());
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
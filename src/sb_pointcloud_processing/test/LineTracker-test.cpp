@@ -0,0 +1,140 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests tracking of lines across frames
+ */
+
+#include "./TestUtils.h"
+#include <LineTracker.h>
+#include <Regression.h>
+#include <gtest/gtest.h>
+
+/**
+ * A frame with a single noisy line
+ */
+static pcl::PointCloud<pcl::PointXYZ>
+makeFrame(std::vector<float> coefficients, float x_min, float x_max) {
+    LineExtractor::TestUtils::LineArgs args(coefficients, x_min, x_max, 0.05);
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl, 0, 0.01);
+    return pcl;
+}
+
+/**
+ * Does what LineExtractorNode does when a frame fails verification, with the
+ * whole frame as a single cluster
+ */
+static void extract(LineTracker& tracker,
+                    const pcl::PointCloud<pcl::PointXYZ>& pcl,
+                    unsigned int poly_degree) {
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters = {pcl};
+    tracker.update(Regression::getLinesOfBestFit(clusters, poly_degree),
+                   clusters);
+}
+
+TEST(LineTracker, NothingToVerifyWithoutTracks) {
+    LineTracker tracker(1);
+    pcl::PointCloud<pcl::PointXYZ> pcl = makeFrame({1, 0.5}, 0, 5);
+
+    EXPECT_FALSE(tracker.verify(PointCloudView(pcl)));
+
+    pcl::PointCloud<pcl::PointXYZ> empty;
+    EXPECT_TRUE(tracker.verify(PointCloudView(empty)));
+}
+
+TEST(LineTracker, StableLineIsVerified) {
+    unsigned int poly_degree = 1;
+    LineTracker tracker(poly_degree);
+    pcl::PointCloud<pcl::PointXYZ> pcl = makeFrame({1, 0.5}, 0, 5);
+
+    extract(tracker, pcl, poly_degree);
+    ASSERT_EQ(1, tracker.getTracks().size());
+
+    for (int frame = 0; frame < 5; frame++) {
+        ASSERT_TRUE(tracker.verify(PointCloudView(pcl)));
+    }
+
+    const LineTracker::Track& track = tracker.getTracks()[0];
+    EXPECT_NEAR(1, track.coefficients(0), 0.02);
+    EXPECT_NEAR(0.5, track.coefficients(1), 0.01);
+    EXPECT_NEAR(0, track.x_min, 0.01);
+    EXPECT_NEAR(5, track.x_max, 0.06);
+    EXPECT_EQ(pcl.size(), tracker.getInliers()[0].size());
+}
+
+TEST(LineTracker, NewLineFailsVerification) {
+    unsigned int poly_degree = 1;
+    LineTracker tracker(poly_degree);
+    pcl::PointCloud<pcl::PointXYZ> pcl = makeFrame({1, 0.5}, 0, 5);
+    extract(tracker, pcl, poly_degree);
+
+    pcl::PointCloud<pcl::PointXYZ> second_line = makeFrame({-3, 0.5}, 0, 5);
+    for (const pcl::PointXYZ& point : second_line) { pcl.push_back(point); }
+
+    EXPECT_FALSE(tracker.verify(PointCloudView(pcl)));
+}
+
+TEST(LineTracker, MovedLineFailsVerification) {
+    unsigned int poly_degree = 1;
+    LineTracker tracker(poly_degree);
+    extract(tracker, makeFrame({1, 0.5}, 0, 5), poly_degree);
+
+    pcl::PointCloud<pcl::PointXYZ> moved = makeFrame({1.5, 0.5}, 0, 5);
+    EXPECT_FALSE(tracker.verify(PointCloudView(moved)));
+}
+
+TEST(LineTracker, UpdateSmoothsMatchedLine) {
+    unsigned int poly_degree = 1;
+    LineTracker tracker(poly_degree, 0.05, 30, 0.2, 0.01, 0.05);
+    extract(tracker, makeFrame({1, 0.5}, 0, 5), poly_degree);
+
+    // A slightly different fit of the same line is blended in rather than
+    // replacing the track
+    extract(tracker, makeFrame({1.06, 0.5}, 0, 5), poly_degree);
+    ASSERT_EQ(1, tracker.getTracks().size());
+    float intercept = tracker.getTracks()[0].coefficients(0);
+    EXPECT_GT(intercept, 1.005);
+    EXPECT_LT(intercept, 1.055);
+}
+
+TEST(LineTracker, UnseenTrackIsDropped) {
+    unsigned int poly_degree = 1;
+    unsigned int max_misses  = 2;
+    LineTracker tracker(poly_degree, 0.05, 30, 0.2, 0.01, 0.05, max_misses);
+    extract(tracker, makeFrame({1, 0.5}, 0, 5), poly_degree);
+
+    // A far away line replaces the first one
+    pcl::PointCloud<pcl::PointXYZ> other = makeFrame({10, 0.5}, 0, 5);
+    for (unsigned int frame = 0; frame < max_misses; frame++) {
+        extract(tracker, other, poly_degree);
+        EXPECT_EQ(2, tracker.getTracks().size());
+    }
+    extract(tracker, other, poly_degree);
+    ASSERT_EQ(1, tracker.getTracks().size());
+    EXPECT_NEAR(10, tracker.getTracks()[0].coefficients(0), 0.02);
+}
+
+TEST(LineTracker, EmptyFrameAfterLastTrackIsDroppedHasNoInliers) {
+    unsigned int poly_degree = 1;
+    unsigned int max_misses  = 2;
+    LineTracker tracker(poly_degree, 0.05, 30, 0.2, 0.01, 0.05, max_misses);
+    pcl::PointCloud<pcl::PointXYZ> pcl = makeFrame({1, 0.5}, 0, 5);
+    extract(tracker, pcl, poly_degree);
+    ASSERT_TRUE(tracker.verify(PointCloudView(pcl)));
+    ASSERT_EQ(1, tracker.getInliers().size());
+
+    // The line goes out of view until its track is dropped
+    for (unsigned int frame = 0; frame <= max_misses; frame++) {
+        tracker.update({}, {});
+    }
+    ASSERT_TRUE(tracker.getTracks().empty());
+
+    pcl::PointCloud<pcl::PointXYZ> empty;
+    EXPECT_TRUE(tracker.verify(PointCloudView(empty)));
+    EXPECT_TRUE(tracker.getInliers().empty());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests calculation of line of best fit with outliers
+ */
+
+#include "./TestUtils.h"
+#include <RansacRegression.h>
+#include <gtest/gtest.h>
+#include <limits>
+
+/**
+ * Adds a band of points far below the line to the given point cloud,
+ * to simulate grass noise picked up by the same cluster
+ */
+static void addOutliersToPointCloud(pcl::PointCloud<pcl::PointXYZ>& pcl,
+                                    float x_min,
+                                    float x_max,
+                                    float x_delta,
+                                    float y) {
+    for (float x = x_min; x <= x_max; x += x_delta) {
+        pcl.push_back(pcl::PointXYZ(x, y, 0));
+    }
+}
+
+TEST(RansacRegression, OnePerfectLinearFit) {
+    unsigned int poly_degree = 1;
+
+    std::vector<float> coefficients = {3, 0.5};
+    LineExtractor::TestUtils::LineArgs args(coefficients, 0, 10, 0.1);
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl);
+
+    RansacRegression regression;
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters = {pcl};
+    std::vector<Eigen::VectorXf> lines =
+    regression.getLinesOfBestFit(clusters, poly_degree);
+
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines[0].size(), coefficients.size());
+
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+        EXPECT_NEAR(lines[0](i), coefficients[i], 0.001);
+    }
+}
+
+TEST(RansacRegression, NonLinearFitIgnoresOutliers) {
+    unsigned int poly_degree = 2;
+
+    std::vector<float> coefficients = {1, 0.2, 0.05};
+    LineExtractor::TestUtils::LineArgs args(coefficients, 0, 10, 0.05);
+
+    float max_noise_x = 0.01;
+    float max_noise_y = 0.01;
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(
+    args, pcl, max_noise_x, max_noise_y);
+
+    // a third of the points are far below the line
+    addOutliersToPointCloud(pcl, 0, 10, 0.1, -5);
+
+    float inlier_threshold = 0.05;
+    RansacRegression regression(inlier_threshold);
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters = {pcl};
+    std::vector<Eigen::VectorXf> lines =
+    regression.getLinesOfBestFit(clusters, poly_degree);
+
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines[0].size(), coefficients.size());
+
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+        EXPECT_NEAR(lines[0](i), coefficients[i], 0.05);
+    }
+}
+
+TEST(RansacRegression, SameSeedGivesSameLine) {
+    unsigned int poly_degree = 3;
+
+    std::vector<float> coefficients = {1, -0.5, 0.1, 0.01};
+    LineExtractor::TestUtils::LineArgs args(coefficients, -5, 5, 0.05);
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl, 0.05, 0.05);
+    addOutliersToPointCloud(pcl, -5, 5, 0.5, 10);
+
+    // without a time budget, so both runs draw the same number of samples
+    float time_budget_ms = std::numeric_limits<float>::infinity();
+    RansacRegression regression(0.05, 0.99, 200, time_budget_ms);
+    Eigen::VectorXf first = regression.getLineOfCluster(pcl, poly_degree, 0, 7);
+    Eigen::VectorXf second =
+    regression.getLineOfCluster(pcl, poly_degree, 0, 7);
+
+    ASSERT_EQ(first.size(), second.size());
+    for (unsigned int i = 0; i < first.size(); i++) {
+        EXPECT_FLOAT_EQ(first(i), second(i));
+    }
+}
+
+TEST(RansacRegression, ExhaustedTimeBudgetStillReturnsLine) {
+    unsigned int poly_degree = 1;
+
+    std::vector<float> coefficients = {2, 1};
+    LineExtractor::TestUtils::LineArgs args(coefficients, 0, 10, 0.1);
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl);
+
+    // no time to draw a single sample, so plain least squares is used
+    float time_budget_ms = 0;
+    RansacRegression regression(0.05, 0.99, 200, time_budget_ms);
+    Eigen::VectorXf line = regression.getLineOfCluster(pcl, poly_degree, 0, 0);
+
+    ASSERT_EQ(line.size(), coefficients.size());
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+        EXPECT_NEAR(line(i), coefficients[i], 0.001);
+    }
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -157,6 +157,65 @@ TEST(Regression, OneNonLinearFitWithNoise) {
     }
 }
 
+TEST(Regression, OnePerfectQuadraticFit) {
+    // Setup PointCloud parameters
+    unsigned int poly_degree = 2;
+
+    float x_min                     = -10;
+    float x_max                     = 10;
+    float x_delta                   = 0.1;
+    std::vector<float> coefficients = {3, -2, 0.5};
+    LineExtractor::TestUtils::LineArgs args(
+    coefficients, x_min, x_max, x_delta);
+
+    // Generate PointCloud
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl);
+
+    // Perform Regression
+    Eigen::VectorXf line = Regression::getLineOfCluster(pcl, poly_degree);
+
+    // Check results
+    ASSERT_EQ(line.size(), coefficients.size());
+
+    for (unsigned int i = 0; i < line.size(); i++) {
+        EXPECT_NEAR(line(i), coefficients[i], 0.001);
+    }
+}
+
+TEST(Regression, OnePerfectFitAboveFixedSizeDegrees) {
+    // Setup PointCloud parameters
+    unsigned int poly_degree = 4;
+
+    float x_min                     = -5;
+    float x_max                     = 5;
+    float x_delta                   = 0.05;
+    std::vector<float> coefficients = {1, 2, -0.5, 0.25, -0.1};
+    LineExtractor::TestUtils::LineArgs args(
+    coefficients, x_min, x_max, x_delta);
+
+    // Generate PointCloud
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    LineExtractor::TestUtils::addLineToPointCloud(args, pcl);
+
+    // Perform Regression
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+    clusters.push_back(pcl);
+
+    std::vector<Eigen::VectorXf> lines =
+    Regression::getLinesOfBestFit(clusters, poly_degree);
+
+    // Check results
+    ASSERT_EQ(lines.size(), 1);
+    Eigen::VectorXf line = lines[0];
+
+    ASSERT_EQ(line.size(), coefficients.size());
+
+    for (unsigned int i = 0; i < line.size(); i++) {
+        EXPECT_NEAR(line(i), coefficients[i], 0.001);
+    }
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
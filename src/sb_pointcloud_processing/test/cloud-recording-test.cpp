@@ -0,0 +1,242 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: GTest for CloudRecordingWriter and CloudRecording
+ */
+
+#include <CloudRecording.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+#include <signal.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+struct TestPoint {
+    float x, y, z;
+    uint32_t rgb;
+};
+
+/*
+ * Builds an unorganized pointcloud message laid out like pcl::PointXYZRGB,
+ * optionally without the rgb field
+ */
+static sensor_msgs::PointCloud2 makeCloud(const std::vector<TestPoint>& points,
+                                          bool with_rgb) {
+    sensor_msgs::PointCloud2 cloud;
+    cloud.height     = 1;
+    cloud.width      = points.size();
+    cloud.point_step = 32;
+    cloud.row_step   = cloud.width * cloud.point_step;
+
+    const char* names[] = {"x", "y", "z", "rgb"};
+    const int offsets[] = {0, 4, 8, 16};
+    for (unsigned int i = 0; i < (with_rgb ? 4 : 3); i++) {
+        sensor_msgs::PointField field;
+        field.name     = names[i];
+        field.offset   = offsets[i];
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count    = 1;
+        cloud.fields.push_back(field);
+    }
+
+    cloud.data.resize(cloud.row_step);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        uint8_t* point_ptr = &cloud.data[i * cloud.point_step];
+        std::memcpy(point_ptr + 0, &points[i].x, sizeof(float));
+        std::memcpy(point_ptr + 4, &points[i].y, sizeof(float));
+        std::memcpy(point_ptr + 8, &points[i].z, sizeof(float));
+        std::memcpy(point_ptr + 16, &points[i].rgb, sizeof(uint32_t));
+    }
+
+    return cloud;
+}
+
+class CloudRecordingTest : public testing::Test {
+  protected:
+    std::string path;
+
+    void SetUp() override {
+        char name[] = "/tmp/cloud-recording-testXXXXXX";
+        int fd      = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override { unlink(path.c_str()); }
+};
+
+TEST_F(CloudRecordingTest, FramesAreReadBackAsRecorded) {
+    std::vector<TestPoint> first  = {{1, 2, 3, 0xff0000}, {4, 5, 6, 0x00ff00}};
+    std::vector<TestPoint> second = {{7, 8, 9, 0x0000ff}};
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    sensor_msgs::PointCloud2 cloud = makeCloud(first, true);
+    cloud.header.seq               = 10;
+    ASSERT_TRUE(writer.append(cloud));
+    cloud            = makeCloud(second, false);
+    cloud.header.seq = 11;
+    ASSERT_TRUE(writer.append(cloud));
+    ASSERT_TRUE(writer.close());
+
+    CloudRecording recording;
+    ASSERT_TRUE(recording.open(path));
+    ASSERT_EQ(2, recording.numFrames());
+
+    CloudRecording::Frame frame = recording.frame(0);
+    EXPECT_EQ(10, frame.seq);
+    ASSERT_EQ(2, frame.num_points);
+    ASSERT_NE(nullptr, frame.rgb);
+    for (unsigned int i = 0; i < first.size(); i++) {
+        EXPECT_FLOAT_EQ(first[i].x, frame.xyz[3 * i]);
+        EXPECT_FLOAT_EQ(first[i].y, frame.xyz[3 * i + 1]);
+        EXPECT_FLOAT_EQ(first[i].z, frame.xyz[3 * i + 2]);
+        EXPECT_EQ(first[i].rgb, frame.rgb[i]);
+    }
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(frame.xyz) % 16);
+
+    frame = recording.frame(1);
+    EXPECT_EQ(11, frame.seq);
+    ASSERT_EQ(1, frame.num_points);
+    EXPECT_EQ(nullptr, frame.rgb);
+
+    PointCloudView view = frame.view();
+    ASSERT_EQ(1, view.size());
+    EXPECT_FLOAT_EQ(7, view.x(0));
+    EXPECT_FLOAT_EQ(8, view.y(0));
+    EXPECT_FLOAT_EQ(9, view.z(0));
+}
+
+TEST_F(CloudRecordingTest, NonFinitePointsAreDropped) {
+    float nan                     = std::numeric_limits<float>::quiet_NaN();
+    std::vector<TestPoint> points = {
+    {1, 2, 3, 1}, {nan, 0, 0, 2}, {4, 5, 6, 3}};
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.append(makeCloud(points, true)));
+    ASSERT_TRUE(writer.close());
+
+    CloudRecording recording;
+    ASSERT_TRUE(recording.open(path));
+    CloudRecording::Frame frame = recording.frame(0);
+    ASSERT_EQ(2, frame.num_points);
+    EXPECT_FLOAT_EQ(4, frame.xyz[3]);
+    EXPECT_EQ(3, frame.rgb[1]);
+}
+
+TEST_F(CloudRecordingTest, EmptyCloudsAreKeptAsEmptyFrames) {
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.append(makeCloud({}, true)));
+    ASSERT_TRUE(writer.close());
+
+    CloudRecording recording;
+    ASSERT_TRUE(recording.open(path));
+    ASSERT_EQ(1, recording.numFrames());
+    EXPECT_EQ(0, recording.frame(0).num_points);
+    EXPECT_TRUE(recording.frame(0).view().empty());
+}
+
+TEST_F(CloudRecordingTest, CloudsWithoutXYAreRejected) {
+    sensor_msgs::PointCloud2 cloud = makeCloud({{1, 2, 3, 0}}, false);
+    cloud.fields[0].datatype       = sensor_msgs::PointField::FLOAT64;
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    EXPECT_FALSE(writer.append(cloud));
+    EXPECT_EQ(0, writer.numFrames());
+}
+
+TEST_F(CloudRecordingTest, MalformedCloudsAreRejected) {
+    sensor_msgs::PointCloud2 cloud = makeCloud({{1, 2, 3, 0}}, true);
+    cloud.data.resize(cloud.data.size() - 1);
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    EXPECT_FALSE(writer.append(cloud));
+    EXPECT_EQ(0, writer.numFrames());
+}
+
+TEST_F(CloudRecordingTest, RgbOutsideThePointIsLeftOut) {
+    sensor_msgs::PointCloud2 cloud = makeCloud({{1, 2, 3, 0}}, true);
+    cloud.fields[3].offset         = cloud.point_step - 2;
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.append(cloud));
+    ASSERT_TRUE(writer.close());
+
+    CloudRecording recording;
+    ASSERT_TRUE(recording.open(path));
+    ASSERT_EQ(1, recording.numFrames());
+    CloudRecording::Frame frame = recording.frame(0);
+    ASSERT_EQ(1, frame.num_points);
+    EXPECT_FLOAT_EQ(2, frame.xyz[1]);
+    EXPECT_EQ(nullptr, frame.rgb);
+}
+
+TEST_F(CloudRecordingTest, InvalidFilesAreRejected) {
+    CloudRecording recording;
+    EXPECT_FALSE(recording.open(path + "-does-not-exist"));
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "definitely not a point cloud recording";
+    }
+    EXPECT_FALSE(recording.open(path));
+
+    // a recording that's been cut short loses its index
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.append(makeCloud({{1, 2, 3, 0}}, true)));
+    ASSERT_TRUE(writer.close());
+    ASSERT_EQ(0, truncate(path.c_str(), 100));
+    EXPECT_FALSE(recording.open(path));
+    EXPECT_EQ(0, recording.numFrames());
+}
+
+TEST_F(CloudRecordingTest, PartlyWrittenFramesAreTruncated) {
+    std::vector<TestPoint> small = {{1, 2, 3, 0}};
+    std::vector<TestPoint> large(10000, {4, 5, 6, 0});
+
+    CloudRecordingWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.append(makeCloud(small, true)));
+
+    // Run out of space part way through the large frame
+    struct rlimit old_limit, limit;
+    ASSERT_EQ(0, getrlimit(RLIMIT_FSIZE, &old_limit));
+    limit          = old_limit;
+    limit.rlim_cur = 4096;
+    signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &limit));
+    bool appended = writer.append(makeCloud(large, true));
+    ASSERT_EQ(0, setrlimit(RLIMIT_FSIZE, &old_limit));
+    signal(SIGXFSZ, SIG_DFL);
+    EXPECT_FALSE(appended);
+    EXPECT_FALSE(writer.hasFailed());
+
+    // Frames after it are written where it would have been
+    ASSERT_TRUE(writer.append(makeCloud(small, false)));
+    ASSERT_TRUE(writer.close());
+
+    CloudRecording recording;
+    ASSERT_TRUE(recording.open(path));
+    ASSERT_EQ(2, recording.numFrames());
+    for (unsigned int i = 0; i < 2; i++) {
+        CloudRecording::Frame frame = recording.frame(i);
+        ASSERT_EQ(1, frame.num_points);
+        EXPECT_FLOAT_EQ(1, frame.xyz[0]);
+        EXPECT_FLOAT_EQ(3, frame.xyz[2]);
+    }
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: Tests for the single pass hue, saturation, value and height
+ *              filter
+ */
+
+#include "ColourHeightFilter.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <limits>
+
+/**
+ * A coloured point, as it would be stored in an RGB pointcloud
+ */
+struct TestPoint {
+    float x, y, z;
+    unsigned char r, g, b;
+};
+
+/**
+ * Builds an unorganized XYZRGB pointcloud message, laid out like
+ * pcl::PointXYZRGB (x, y, z, padding, rgb, padding)
+ */
+static sensor_msgs::PointCloud2
+makeCloud(const std::vector<TestPoint>& points) {
+    sensor_msgs::PointCloud2 cloud;
+    cloud.height     = 1;
+    cloud.width      = points.size();
+    cloud.point_step = 32;
+    cloud.row_step   = cloud.width * cloud.point_step;
+
+    const char* names[] = {"x", "y", "z", "rgb"};
+    const int offsets[] = {0, 4, 8, 16};
+    for (unsigned int i = 0; i < 4; i++) {
+        sensor_msgs::PointField field;
+        field.name     = names[i];
+        field.offset   = offsets[i];
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count    = 1;
+        cloud.fields.push_back(field);
+    }
+
+    cloud.data.resize(cloud.row_step);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        uint8_t* point_ptr = &cloud.data[i * cloud.point_step];
+        std::memcpy(point_ptr + 0, &points[i].x, sizeof(float));
+        std::memcpy(point_ptr + 4, &points[i].y, sizeof(float));
+        std::memcpy(point_ptr + 8, &points[i].z, sizeof(float));
+        uint32_t rgb = ((uint32_t) points[i].r << 16) |
+                       ((uint32_t) points[i].g << 8) | points[i].b;
+        std::memcpy(point_ptr + 16, &rgb, sizeof(uint32_t));
+    }
+
+    return cloud;
+}
+
+/**
+ * Reads back the xyz of the i-th point of the filter output
+ */
+static void getPoint(const sensor_msgs::PointCloud2& cloud,
+                     unsigned int i,
+                     float& x,
+                     float& y,
+                     float& z) {
+    const uint8_t* point_ptr = &cloud.data[i * cloud.point_step];
+    std::memcpy(&x, point_ptr + 0, sizeof(float));
+    std::memcpy(&y, point_ptr + 4, sizeof(float));
+    std::memcpy(&z, point_ptr + 8, sizeof(float));
+}
+
+TEST(ColourHeightFilter, keepsGreenPointsWithinHeight) {
+    ColourHeightFilter filter;
+    filter.setHueLimits(115, 125);
+    filter.setSaturationLimits(0.735, 0.745);
+    filter.setValueLimits(0.675, 0.685);
+    filter.setHeightLimits(1, 2);
+
+    std::vector<TestPoint> points = {
+    {0, 1, 1.5, 45, 174, 45},  // green, in height range
+    {0, 2, 1.5, 243, 136, 35}, // orange, in height range
+    {0, 3, 5, 45, 174, 45},    // green, too high
+    {0, 4, 1, 45, 174, 45},    // green, on the height limit
+    {0, 5, 1.5, 0, 0, 0},      // black, in height range
+    };
+
+    sensor_msgs::PointCloud2 output;
+    ASSERT_TRUE(filter.filter(makeCloud(points), output));
+
+    ASSERT_EQ(2, output.width);
+    ASSERT_EQ(1, output.height);
+    ASSERT_EQ(output.width * output.point_step, output.data.size());
+
+    float x, y, z;
+    getPoint(output, 0, x, y, z);
+    EXPECT_FLOAT_EQ(1, y);
+    EXPECT_FLOAT_EQ(1.5, z);
+
+    getPoint(output, 1, x, y, z);
+    EXPECT_FLOAT_EQ(4, y);
+    EXPECT_FLOAT_EQ(1, z);
+}
+
+TEST(ColourHeightFilter, dropsNonFinitePoints) {
+    ColourHeightFilter filter;
+
+    float nan                     = std::numeric_limits<float>::quiet_NaN();
+    std::vector<TestPoint> points = {{nan, nan, nan, 45, 174, 45},
+                                     {0, 0, 0, 45, 174, 45}};
+
+    sensor_msgs::PointCloud2 output;
+    ASSERT_TRUE(filter.filter(makeCloud(points), output));
+
+    EXPECT_EQ(1, output.width);
+}
+
+TEST(ColourHeightFilter, appliesTransformBeforeHeightCheck) {
+    ColourHeightFilter filter;
+    filter.setHeightLimits(1.5, 2.5);
+    filter.setTransform(Eigen::Affine3f(Eigen::Translation3f(0, 0, 2)));
+
+    std::vector<TestPoint> points = {{0, 0, 0, 45, 174, 45},
+                                     {0, 0, 2, 45, 174, 45}};
+
+    sensor_msgs::PointCloud2 output;
+    ASSERT_TRUE(filter.filter(makeCloud(points), output));
+
+    ASSERT_EQ(1, output.width);
+    float x, y, z;
+    getPoint(output, 0, x, y, z);
+    EXPECT_FLOAT_EQ(2, z);
+}
+
+TEST(ColourHeightFilter, rejectsCloudWithoutColour) {
+    ColourHeightFilter filter;
+
+    sensor_msgs::PointCloud2 input = makeCloud({{0, 0, 0, 45, 174, 45}});
+    input.fields.pop_back();
+
+    sensor_msgs::PointCloud2 output;
+    EXPECT_FALSE(filter.filter(input, output));
+}
+
+TEST(ColourHeightFilter, rejectsMalformedCloud) {
+    ColourHeightFilter filter;
+    sensor_msgs::PointCloud2 valid =
+    makeCloud({{0, 0, 0, 45, 174, 45}, {1, 1, 1, 45, 174, 45}});
+    sensor_msgs::PointCloud2 output;
+
+    // rows longer than the data
+    sensor_msgs::PointCloud2 input = valid;
+    input.data.pop_back();
+    EXPECT_FALSE(filter.filter(input, output));
+
+    // points longer than a row
+    input = valid;
+    input.row_step--;
+    EXPECT_FALSE(filter.filter(input, output));
+
+    // fields outside a point
+    input            = valid;
+    input.point_step = 16;
+    input.row_step   = input.width * input.point_step;
+    EXPECT_FALSE(filter.filter(input, output));
+
+    EXPECT_TRUE(filter.filter(valid, output));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -74,6 +74,58 @@ TEST(ColourspaceConverter, convertPointclouds) {
     ASSERT_EQ(4, comparisons);
 }
 
+TEST(ColourspaceConverter, batchConversionMatchesPointConversion) {
+    ColourspaceConverter c = ColourspaceConverter();
+
+    // Sample the RGB cube, and end with a number of points that isn't a
+    // multiple of the batch size so the scalar fallback is used too
+    pcl::PointCloud<pcl::PointXYZRGB>::Ptr input(
+    new pcl::PointCloud<pcl::PointXYZRGB>());
+    for (int r = 0; r < 256; r += 5) {
+        for (int g = 0; g < 256; g += 5) {
+            for (int b = 0; b < 256; b += 5) {
+                PointXYZRGB p;
+                p.r = r;
+                p.g = g;
+                p.b = b;
+                p.x = r;
+                p.y = g;
+                p.z = b;
+                input->points.push_back(p);
+            }
+        }
+    }
+    input->points.resize(input->points.size() + 3);
+    input->height = 1;
+    input->width  = input->points.size();
+
+    c.setInputCloud(input);
+
+    pcl::PointCloud<pcl::PointXYZHSV>::Ptr output(
+    new pcl::PointCloud<pcl::PointXYZHSV>());
+    c.convertBatch(*output);
+
+    ASSERT_EQ(input->points.size(), output->points.size());
+    ASSERT_EQ(input->width, output->width);
+    ASSERT_EQ(input->height, output->height);
+
+    for (size_t i = 0; i < input->points.size(); i++) {
+        PointXYZHSV expected;
+        c.PointXYZRGBAtoXYZHSV(input->points[i], expected);
+        const PointXYZHSV& actual = output->points[i];
+
+        ASSERT_EQ(expected.x, actual.x);
+        ASSERT_EQ(expected.y, actual.y);
+        ASSERT_EQ(expected.z, actual.z);
+
+        // Hue wraps around at 360
+        float h_error = std::fabs(expected.h - actual.h);
+        ASSERT_NEAR(0, std::min(h_error, 360 - h_error), 0.001);
+        ASSERT_NEAR(expected.s, actual.s, 0.00001);
+        ASSERT_NEAR(expected.v, actual.v, 0.00001);
+    }
+}
+
 int main(int argc, char** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
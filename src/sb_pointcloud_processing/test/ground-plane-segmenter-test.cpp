@@ -0,0 +1,183 @@
+/**
+ * Created by: agent
+ * Created on: October 18, 2026
+ * Description: Tests for the RANSAC ground plane segmenter
+ */
+
+#include "GroundPlaneSegmenter.h"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+
+/**
+ * Builds an unorganized XYZ pointcloud message, laid out like
+ * pcl::PointXYZ (x, y, z, padding)
+ */
+static sensor_msgs::PointCloud2
+makeCloud(const std::vector<Eigen::Vector3f>& points) {
+    sensor_msgs::PointCloud2 cloud;
+    cloud.height     = 1;
+    cloud.width      = points.size();
+    cloud.point_step = 16;
+    cloud.row_step   = cloud.width * cloud.point_step;
+
+    const char* names[] = {"x", "y", "z"};
+    for (unsigned int i = 0; i < 3; i++) {
+        sensor_msgs::PointField field;
+        field.name     = names[i];
+        field.offset   = i * sizeof(float);
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count    = 1;
+        cloud.fields.push_back(field);
+    }
+
+    cloud.data.resize(cloud.row_step);
+    for (unsigned int i = 0; i < points.size(); i++) {
+        std::memcpy(
+        &cloud.data[i * cloud.point_step], points[i].data(), 3 * sizeof(float));
+    }
+
+    return cloud;
+}
+
+/**
+ * A grid of points on the plane z = slope * x + height, with every fifth
+ * point lifted @outlier_height above it
+ */
+static std::vector<Eigen::Vector3f>
+makeGround(float slope, float height, float outlier_height) {
+    std::vector<Eigen::Vector3f> points;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            float x = i * 0.1, y = j * 0.1 - 2;
+            float z = slope * x + height;
+            if ((i * 40 + j) % 5 == 0) z += outlier_height;
+            points.push_back(Eigen::Vector3f(x, y, z));
+        }
+    }
+    return points;
+}
+
+TEST(GroundPlaneSegmenter, FindsSlopedPlaneDespiteOutliers) {
+    GroundPlaneSegmenter segmenter;
+    std::vector<Eigen::Vector3f> points = makeGround(0.2, -0.5, 1.0);
+
+    ASSERT_TRUE(segmenter.estimatePlane(points));
+
+    Eigen::Vector3f expected_normal = Eigen::Vector3f(-0.2, 0, 1).normalized();
+    Eigen::Vector4f plane           = segmenter.plane();
+    EXPECT_NEAR(1, plane.head<3>().dot(expected_normal), 1e-4);
+    // (0, 0, -0.5) lies on the plane
+    EXPECT_NEAR(0, plane[2] * -0.5 + plane[3], 1e-3);
+}
+
+TEST(GroundPlaneSegmenter, KeepsPointsWithinBand) {
+    GroundPlaneSegmenter segmenter;
+    segmenter.setBand(-0.05, 0.1);
+    std::vector<Eigen::Vector3f> points = makeGround(0.2, -0.5, 1.0);
+
+    // A lane marking barely above the ground, and one too far below it
+    points.push_back(Eigen::Vector3f(1, 0, 0.2 * 1 - 0.5 + 0.05));
+    points.push_back(Eigen::Vector3f(1, 0, 0.2 * 1 - 0.5 - 0.2));
+
+    sensor_msgs::PointCloud2 output;
+    ASSERT_TRUE(segmenter.segment(makeCloud(points), output));
+
+    // The ground and the lane marking, but none of the outliers
+    EXPECT_EQ(40 * 40 * 4 / 5 + 1, output.width);
+    EXPECT_EQ(output.width * output.point_step, output.data.size());
+    for (unsigned int i = 0; i < output.width; i++) {
+        float p[3];
+        std::memcpy(p, &output.data[i * output.point_step], sizeof(p));
+        EXPECT_NEAR(0.2 * p[0] - 0.5, p[2], 0.11);
+    }
+}
+
+TEST(GroundPlaneSegmenter, WarmStartTracksMovingPlane) {
+    GroundPlaneSegmenter segmenter(0.03, 0.35, 500, 100, 2, 7);
+
+    // The plane tilts a little more every cloud, as if the robot pitched
+    for (int k = 0; k <= 5; k++) {
+        float slope = 0.04 * k;
+        ASSERT_TRUE(segmenter.estimatePlane(makeGround(slope, -0.5, 1.0)));
+        Eigen::Vector3f expected_normal =
+        Eigen::Vector3f(-slope, 0, 1).normalized();
+        EXPECT_NEAR(1, segmenter.plane().head<3>().dot(expected_normal), 1e-4);
+    }
+}
+
+TEST(GroundPlaneSegmenter, KeepsPreviousPlaneWithoutGround) {
+    GroundPlaneSegmenter segmenter;
+    ASSERT_TRUE(segmenter.estimatePlane(makeGround(0, -0.5, 1.0)));
+    Eigen::Vector4f previous = segmenter.plane();
+
+    // A vertical wall is too tilted to be the ground
+    std::vector<Eigen::Vector3f> wall;
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++) {
+            wall.push_back(Eigen::Vector3f(2, i * 0.1, j * 0.1));
+        }
+    }
+    EXPECT_FALSE(segmenter.estimatePlane(wall));
+    EXPECT_TRUE(previous.isApprox(segmenter.plane()));
+
+    segmenter.reset();
+    EXPECT_TRUE(Eigen::Vector4f(0, 0, 1, 0).isApprox(segmenter.plane()));
+}
+
+TEST(GroundPlaneSegmenter, RejectsCloudWithoutXYZ) {
+    GroundPlaneSegmenter segmenter;
+    sensor_msgs::PointCloud2 input = makeCloud({Eigen::Vector3f(0, 0, 0)});
+    input.fields.pop_back();
+
+    sensor_msgs::PointCloud2 output;
+    EXPECT_FALSE(segmenter.segment(input, output));
+}
+
+TEST(GroundPlaneSegmenter, FiltersWithPlaneOfAnotherCloud) {
+    GroundPlaneSegmenter segmenter;
+    segmenter.setBand(-0.05, 0.1);
+    ASSERT_TRUE(segmenter.updatePlane(makeCloud(makeGround(0.2, -0.5, 1.0))));
+
+    // A few lane points, too few and too close together to fit a plane to,
+    // and a white obstacle well above the ground
+    std::vector<Eigen::Vector3f> lane = {Eigen::Vector3f(1, 0, -0.3),
+                                         Eigen::Vector3f(1.1, 0, -0.28),
+                                         Eigen::Vector3f(1.2, 0.01, -0.26),
+                                         Eigen::Vector3f(1.5, 0.5, 0.5)};
+    Eigen::Vector4f plane = segmenter.plane();
+
+    sensor_msgs::PointCloud2 output;
+    ASSERT_TRUE(segmenter.filter(makeCloud(lane), output));
+    EXPECT_EQ(3, output.width);
+    EXPECT_TRUE(plane.isApprox(segmenter.plane()));
+}
+
+TEST(GroundPlaneSegmenter, RejectsMalformedCloud) {
+    GroundPlaneSegmenter segmenter;
+    sensor_msgs::PointCloud2 valid = makeCloud(makeGround(0, -0.5, 1.0));
+    sensor_msgs::PointCloud2 output;
+
+    // rows longer than the data
+    sensor_msgs::PointCloud2 input = valid;
+    input.data.pop_back();
+    EXPECT_FALSE(segmenter.segment(input, output));
+
+    // points longer than a row
+    input = valid;
+    input.row_step--;
+    EXPECT_FALSE(segmenter.updatePlane(input));
+
+    // fields outside a point
+    input            = valid;
+    input.point_step = 8;
+    input.row_step   = input.width * input.point_step;
+    EXPECT_FALSE(segmenter.filter(input, output));
+
+    EXPECT_TRUE(segmenter.segment(valid, output));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -7,6 +7,7 @@
 #include "./TestUtils.h"
 #include <gtest/gtest.h>
 #include <mapping_igvc/LineObstacle.h>
+#include <mapping_igvc/LineObstacleArray.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <std_msgs/Float32.h>
 
@@ -31,6 +32,11 @@ class LineExtractorRosTest : public testing::Test {
                       1,
                       &LineExtractorRosTest::callback,
                       this);
+        test_array_subscriber =
+        nh_.subscribe("/line_extractor_node/output_line_obstacles",
+                      1,
+                      &LineExtractorRosTest::arrayCallback,
+                      this);
 
         // Let the publishers and subscribers set itself up timely
         ros::Rate loop_rate(1);
@@ -39,13 +45,19 @@ class LineExtractorRosTest : public testing::Test {
 
     ros::NodeHandle nh_;
     mapping_igvc::LineObstacle lineObstacle;
+    mapping_igvc::LineObstacleArray lineObstacleArray;
     ros::Publisher test_publisher;
     ros::Subscriber test_subscriber;
+    ros::Subscriber test_array_subscriber;
 
   public:
     void callback(const mapping_igvc::LineObstacle& line) {
         lineObstacle = line;
     }
+
+    void arrayCallback(const mapping_igvc::LineObstacleArray& lines) {
+        lineObstacleArray = lines;
+    }
 };
 
 TEST_F(LineExtractorRosTest, TestTwoNonLinearLinesWithNoise) {
@@ -103,6 +115,18 @@ TEST_F(LineExtractorRosTest, TestTwoNonLinearLinesWithNoise) {
 
     EXPECT_FLOAT_EQ(lineObstacle.x_min, true_min);
     EXPECT_FLOAT_EQ(lineObstacle.x_max, true_max);
+
+    // The same line is in the message of the whole frame
+    ASSERT_EQ(lineObstacleArray.num_coefficients, coefficients.size());
+    ASSERT_EQ(1, lineObstacleArray.x_min.size());
+    ASSERT_EQ(1, lineObstacleArray.x_max.size());
+    ASSERT_EQ(lineObstacleArray.coefficients.size(), coefficients.size());
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+        EXPECT_DOUBLE_EQ(lineObstacleArray.coefficients[i],
+                         lineObstacle.coefficients[i]);
+    }
+    EXPECT_DOUBLE_EQ(lineObstacleArray.x_min[0], lineObstacle.x_min);
+    EXPECT_DOUBLE_EQ(lineObstacleArray.x_max[0], lineObstacle.x_max);
 }
 
 int main(int argc, char** argv) {
@@ -0,0 +1,126 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: GTest for OccupancyGridProjector
+ */
+
+#include <OccupancyGridProjector.h>
+#include <gtest/gtest.h>
+
+class OccupancyGridProjectorTest : public testing::Test {
+  protected:
+    // 10 x 10 cells of 1m, with the sensor in the middle of cell (0, 5)
+    OccupancyGridProjectorTest()
+      : projector(10, 10, 1.0, -1),
+        grid_origin(0, 0),
+        sensor_origin(0.5, 5.5) {}
+
+    void addPoint(float x, float y, float z = 0) {
+        pcl::PointXYZ p;
+        p.x = x;
+        p.y = y;
+        p.z = z;
+        pcl.push_back(p);
+    }
+
+    int8_t cell(int col, int row) { return grid[row * 10 + col]; }
+
+    OccupancyGridProjector projector;
+    Eigen::Vector2f grid_origin;
+    Eigen::Vector2f sensor_origin;
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    std::vector<int8_t> grid;
+};
+
+TEST_F(OccupancyGridProjectorTest, EmptyCloudLeavesEverythingUnknown) {
+    projector.project(PointCloudView(pcl),
+                      Eigen::Affine3f::Identity(),
+                      grid_origin,
+                      sensor_origin,
+                      grid);
+
+    ASSERT_EQ(100, grid.size());
+    for (int8_t value : grid) { EXPECT_EQ(-1, value); }
+}
+
+TEST_F(OccupancyGridProjectorTest, RayToObstacleIsFree) {
+    addPoint(5.5, 5.5);
+
+    projector.project(PointCloudView(pcl),
+                      Eigen::Affine3f::Identity(),
+                      grid_origin,
+                      sensor_origin,
+                      grid);
+
+    EXPECT_EQ(OccupancyGridProjector::GRID_OCCUPIED, cell(5, 5));
+    for (int col = 0; col < 5; col++) {
+        EXPECT_EQ(OccupancyGridProjector::GRID_FREE, cell(col, 5));
+    }
+    // Behind the obstacle and off the ray is unknown
+    EXPECT_EQ(-1, cell(6, 5));
+    EXPECT_EQ(-1, cell(2, 2));
+}
+
+TEST_F(OccupancyGridProjectorTest, ObstaclesStayOccupiedOnOtherRays) {
+    addPoint(2.5, 5.5);
+    addPoint(5.5, 5.5);
+
+    projector.project(PointCloudView(pcl),
+                      Eigen::Affine3f::Identity(),
+                      grid_origin,
+                      sensor_origin,
+                      grid);
+
+    EXPECT_EQ(OccupancyGridProjector::GRID_OCCUPIED, cell(2, 5));
+    EXPECT_EQ(OccupancyGridProjector::GRID_OCCUPIED, cell(5, 5));
+    EXPECT_EQ(OccupancyGridProjector::GRID_FREE, cell(4, 5));
+}
+
+TEST_F(OccupancyGridProjectorTest, PointsAreTransformedAndClipped) {
+    // Shifted 3m along x into the grid
+    addPoint(2.5, 1.5);
+    // Outside of the grid even after the shift
+    addPoint(20, 1.5);
+    addPoint(-5, 1.5);
+
+    Eigen::Affine3f transform(Eigen::Translation3f(3, 0, 0));
+    projector.project(
+    PointCloudView(pcl), transform, grid_origin, sensor_origin, grid);
+
+    int occupied = 0;
+    for (int8_t value : grid) {
+        if (value == OccupancyGridProjector::GRID_OCCUPIED) occupied++;
+    }
+    EXPECT_EQ(1, occupied);
+    EXPECT_EQ(OccupancyGridProjector::GRID_OCCUPIED, cell(5, 1));
+}
+
+TEST_F(OccupancyGridProjectorTest, ParallelProjectionMatchesSmallCloud) {
+    // Enough points to be binned in parallel, all on two cells
+    for (int i = 0; i < 5000; i++) {
+        addPoint(7.1 + (i % 10) * 0.05, 8.5);
+        addPoint(7.5, 1.1 + (i % 10) * 0.05);
+    }
+    projector.project(PointCloudView(pcl),
+                      Eigen::Affine3f::Identity(),
+                      grid_origin,
+                      sensor_origin,
+                      grid);
+    std::vector<int8_t> parallel_grid = grid;
+
+    pcl.clear();
+    addPoint(7.5, 8.5);
+    addPoint(7.5, 1.5);
+    projector.project(PointCloudView(pcl),
+                      Eigen::Affine3f::Identity(),
+                      grid_origin,
+                      sensor_origin,
+                      grid);
+
+    EXPECT_EQ(grid, parallel_grid);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
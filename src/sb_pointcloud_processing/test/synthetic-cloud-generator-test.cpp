@@ -0,0 +1,122 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: GTest for SyntheticCloudGenerator
+ */
+
+#include <PointCloudView.h>
+#include <SyntheticCloudGenerator.h>
+#include <cmath>
+#include <gtest/gtest.h>
+
+static SyntheticCloudGenerator::Line makeLine(std::vector<float> coefficients,
+                                              unsigned int num_points) {
+    SyntheticCloudGenerator::Line line;
+    line.coefficients = coefficients;
+    line.x_min        = -5;
+    line.x_max        = 5;
+    line.num_points   = num_points;
+    line.noise_x      = 0.1;
+    line.noise_y      = 0.2;
+    return line;
+}
+
+TEST(SyntheticCloudGenerator, LinePointsStayWithinTheirNoise) {
+    SyntheticCloudGenerator generator;
+    generator.addLine(makeLine({1, 0.5, -0.1}, 101));
+
+    sensor_msgs::PointCloud2 cloud;
+    generator.generate(cloud);
+
+    ASSERT_EQ(101, cloud.width);
+    ASSERT_EQ(1, cloud.height);
+    EXPECT_TRUE(cloud.is_dense);
+
+    PointCloudView view(cloud);
+    ASSERT_EQ(101, view.size());
+    for (size_t i = 0; i < view.size(); i++) {
+        float true_x = -5 + 0.1 * i;
+        float true_y = 1 + 0.5 * true_x - 0.1 * true_x * true_x;
+        EXPECT_NEAR(true_x, view.x(i), 0.1 + 1e-4);
+        // the x noise moves the point along the curve too
+        EXPECT_NEAR(true_y, view.y(i), 0.2 + 0.1 * 1.6 + 1e-3);
+        EXPECT_EQ(0, view.z(i));
+    }
+}
+
+TEST(SyntheticCloudGenerator, ConePointsLieOnTheCone) {
+    SyntheticCloudGenerator generator;
+    SyntheticCloudGenerator::Cone cone = {2, -1, 0.15, 0.45, 500};
+    generator.addCone(cone);
+
+    sensor_msgs::PointCloud2 cloud;
+    generator.generate(cloud);
+
+    PointCloudView view(cloud);
+    ASSERT_EQ(500, view.size());
+    for (size_t i = 0; i < view.size(); i++) {
+        float r = std::hypot(view.x(i) - cone.x, view.y(i) - cone.y);
+        ASSERT_GE(view.z(i), 0);
+        ASSERT_LE(view.z(i), cone.height + 1e-5);
+        EXPECT_NEAR(cone.radius * (1 - view.z(i) / cone.height), r, 1e-4);
+    }
+}
+
+TEST(SyntheticCloudGenerator, SameSeedGivesSameFrames) {
+    SyntheticCloudGenerator first(7), second(7), other(8);
+    for (SyntheticCloudGenerator* generator : {&first, &second, &other}) {
+        generator->addLine(makeLine({0, 1}, 50000));
+        generator->addRandomLines(4, 3, -5, 5, 5, 20000, 0.1);
+        generator->addRandomCones(3, 0, 5, 5, 0.15, 0.45, 1000);
+        generator->addClutter({0, 0, 2, 0.1, 40000});
+    }
+    ASSERT_EQ(50000 + 4 * 20000 + 3 * 1000 + 40000, first.numPoints());
+
+    sensor_msgs::PointCloud2 a, b, c;
+    first.generate(a);
+    second.generate(b);
+    other.generate(c);
+    EXPECT_EQ(a.data, b.data);
+    EXPECT_NE(a.data, c.data);
+
+    // frames differ, but the sequence restarts on reset
+    first.generate(b);
+    EXPECT_NE(a.data, b.data);
+    first.reset();
+    first.generate(b);
+    EXPECT_EQ(a.data, b.data);
+}
+
+TEST(SyntheticCloudGenerator, OrganisedCloudsArePaddedWithNaN) {
+    SyntheticCloudGenerator generator;
+    generator.addLine(makeLine({0}, 25));
+    generator.setOrganisedWidth(10);
+
+    sensor_msgs::PointCloud2 cloud;
+    generator.generate(cloud);
+
+    ASSERT_EQ(10, cloud.width);
+    ASSERT_EQ(3, cloud.height);
+    EXPECT_FALSE(cloud.is_dense);
+
+    PointCloudView view(cloud);
+    ASSERT_EQ(30, view.size());
+    for (size_t i = 0; i < 25; i++) { EXPECT_FALSE(std::isnan(view.x(i))); }
+    for (size_t i = 25; i < 30; i++) { EXPECT_TRUE(std::isnan(view.x(i))); }
+}
+
+TEST(SyntheticCloudGenerator, BufferIsReusedBetweenFrames) {
+    SyntheticCloudGenerator generator;
+    generator.addClutter({0, 0, 1, 0, 100000});
+
+    sensor_msgs::PointCloud2 cloud;
+    generator.generate(cloud);
+    const uint8_t* buffer = cloud.data.data();
+    generator.generate(cloud);
+    EXPECT_EQ(buffer, cloud.data.data());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
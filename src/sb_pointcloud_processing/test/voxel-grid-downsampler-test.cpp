@@ -0,0 +1,130 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: GTest for VoxelGridDownsampler
+ */
+
+#include <VoxelGridDownsampler.h>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+static pcl::PointXYZ makePoint(float x, float y, float z) {
+    pcl::PointXYZ p;
+    p.x = x;
+    p.y = y;
+    p.z = z;
+    return p;
+}
+
+TEST(VoxelGridDownsampler, PointsInOneCellBecomeTheirCentroid) {
+    VoxelGridDownsampler downsampler(1.0);
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    pcl.push_back(makePoint(0.1, 0.2, 0.3));
+    pcl.push_back(makePoint(0.3, 0.4, 0.5));
+    pcl.push_back(makePoint(0.5, 0.6, 0.7));
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+    downsampler.downsample(PointCloudView(pcl), output);
+
+    ASSERT_EQ(1, output.size());
+    EXPECT_FLOAT_EQ(0.3, output.points[0].x);
+    EXPECT_FLOAT_EQ(0.4, output.points[0].y);
+    EXPECT_FLOAT_EQ(0.5, output.points[0].z);
+}
+
+TEST(VoxelGridDownsampler, OnePointPerOccupiedCell) {
+    VoxelGridDownsampler downsampler(0.1);
+
+    // 10 x 10 points spaced 0.05 apart fill 5 x 5 cells
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            pcl.push_back(makePoint(0.025 + 0.05 * i, 0.025 + 0.05 * j, 0));
+        }
+    }
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+    downsampler.downsample(PointCloudView(pcl), output);
+
+    EXPECT_EQ(25, output.size());
+}
+
+TEST(VoxelGridDownsampler, NegativeCoordinatesGetTheirOwnCells) {
+    VoxelGridDownsampler downsampler(1.0);
+
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    pcl.push_back(makePoint(0.5, 0.5, 0));
+    pcl.push_back(makePoint(-0.5, 0.5, 0));
+    pcl.push_back(makePoint(0.5, -0.5, 0));
+    pcl.push_back(makePoint(-0.5, -0.5, 0));
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+    downsampler.downsample(PointCloudView(pcl), output);
+
+    EXPECT_EQ(4, output.size());
+}
+
+TEST(VoxelGridDownsampler, TwoDimensionalGridIgnoresHeight) {
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    for (int k = 0; k < 5; k++) { pcl.push_back(makePoint(0.5, 0.5, k)); }
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+
+    VoxelGridDownsampler downsampler_3d(1.0, true);
+    downsampler_3d.downsample(PointCloudView(pcl), output);
+    EXPECT_EQ(5, output.size());
+
+    VoxelGridDownsampler downsampler_2d(1.0, false);
+    downsampler_2d.downsample(PointCloudView(pcl), output);
+    ASSERT_EQ(1, output.size());
+    EXPECT_FLOAT_EQ(2, output.points[0].z);
+}
+
+TEST(VoxelGridDownsampler, NonFinitePointsAreSkipped) {
+    VoxelGridDownsampler downsampler(1.0);
+
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    pcl.push_back(makePoint(nan, 0, 0));
+    pcl.push_back(makePoint(0, 0, std::numeric_limits<float>::infinity()));
+    pcl.push_back(makePoint(0.5, 0.5, 0.5));
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+    downsampler.downsample(PointCloudView(pcl), output);
+
+    ASSERT_EQ(1, output.size());
+    EXPECT_FLOAT_EQ(0.5, output.points[0].x);
+}
+
+TEST(VoxelGridDownsampler, OutputNeverExceedsPointBudget) {
+    unsigned int max_points = 100;
+    VoxelGridDownsampler downsampler(0.01, true, max_points);
+
+    // 1000 points, all in different cells
+    pcl::PointCloud<pcl::PointXYZ> pcl;
+    for (int i = 0; i < 1000; i++) { pcl.push_back(makePoint(i, 0, 0)); }
+
+    pcl::PointCloud<pcl::PointXYZ> output;
+    downsampler.downsample(PointCloudView(pcl), output);
+
+    ASSERT_EQ(max_points, output.size());
+    // The points kept are spread over the whole cloud
+    EXPECT_FLOAT_EQ(0, output.points.front().x);
+    EXPECT_FLOAT_EQ(990, output.points.back().x);
+
+    // Without binning, only the budget applies
+    downsampler.setLeafSize(0);
+    downsampler.downsample(PointCloudView(pcl), output);
+    EXPECT_EQ(max_points, output.size());
+
+    downsampler.setMaxPoints(0);
+    downsampler.downsample(PointCloudView(pcl), output);
+    EXPECT_EQ(1000, output.size());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A publisher for debug visualisation that only builds its
+ *              messages when someone is subscribed, no faster than a given
+ *              rate, and optionally on its own thread
+ *
+ */
+#ifndef SB_UTILS_DEBUGPUBLISHER_H
+#define SB_UTILS_DEBUGPUBLISHER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ros/ros.h>
+#include <string>
+#include <thread>
+
+namespace snowbots {
+template <class M> class DebugPublisher {
+  public:
+    /**
+     * A message builder, called only when the message will be published.
+     * Data it needs should be moved into it rather than referenced, since it
+     * may run after the caller has moved on to the next frame.
+     */
+    typedef std::function<M()> Builder;
+
+    DebugPublisher() : async(false), stopped(false) {}
+
+    ~DebugPublisher() { stopWorker(); }
+
+    DebugPublisher(const DebugPublisher&) = delete;
+    DebugPublisher& operator=(const DebugPublisher&) = delete;
+
+    /**
+     *  Advertises the debug topic
+     *
+     *  @param nh the node handle to advertise on
+     *  @param topic the topic name
+     *  @param max_rate the most messages per second to publish,
+     *  0 for no limit
+     *  @param async whether messages are built and published on a
+     *  background thread instead of the caller's
+     */
+    void advertise(ros::NodeHandle& nh,
+                   const std::string& topic,
+                   double max_rate = 10,
+                   bool async      = true) {
+        stopWorker();
+
+        this->publisher = nh.advertise<M>(topic, 1);
+        this->period = ros::WallDuration(max_rate > 0 ? 1.0 / max_rate : 0.0);
+        this->async  = async;
+        this->last_publish = ros::WallTime();
+    }
+
+    /**
+     *  Checks whether a message published now would go out, so callers can
+     *  skip the work of collecting the data for it
+     *
+     *  @return true if someone is subscribed and the rate limit allows it
+     */
+    bool isActive() const {
+        return this->publisher && this->publisher.getNumSubscribers() > 0 &&
+               ros::WallTime::now() - this->last_publish >= this->period;
+    }
+
+    /**
+     *  Publishes the message made by @build if the topic is active.
+     *  If the previous message is still waiting on the background thread it
+     *  is dropped in favour of this one.
+     *
+     *  @param build makes the message to publish
+     *
+     *  @return true if the message was (or will be) published
+     */
+    bool publish(Builder build) {
+        if (!isActive()) return false;
+
+        this->last_publish = ros::WallTime::now();
+
+        if (!this->async) {
+            this->publisher.publish(build());
+            return true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->pending = std::move(build);
+            if (!this->worker.joinable()) {
+                this->worker = std::thread(&DebugPublisher::run, this);
+            }
+        }
+        this->condition.notify_one();
+
+        return true;
+    }
+
+  private:
+    ros::Publisher publisher;
+    ros::WallDuration period;
+    ros::WallTime last_publish;
+    bool async;
+
+    // Latest message waiting to be built by the worker
+    Builder pending;
+    bool stopped;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::thread worker;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (true) {
+            this->condition.wait(
+            lock, [this] { return this->stopped || this->pending; });
+            if (this->stopped) return;
+
+            Builder build = std::move(this->pending);
+            this->pending = nullptr;
+
+            lock.unlock();
+            this->publisher.publish(build());
+            lock.lock();
+        }
+    }
+
+    void stopWorker() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopped = true;
+        }
+        this->condition.notify_all();
+        if (this->worker.joinable()) this->worker.join();
+
+        this->stopped = false;
+        this->pending = nullptr;
+    }
+};
+} // namespace snowbots
+#endif // SB_UTILS_DEBUGPUBLISHER_H
@@ -18,7 +18,8 @@ class RvizUtils {
     /**
      *  Turn points into a marker for rviz
      *
-     *  @param points the points to be converted
+     *  @param points the points to be converted, moved into the marker
+     *  (pass an rvalue to avoid copying them)
      *  @param color the color of the points
      *  @param frame_id the frame id
      *  @param ns the namespace
@@ -29,8 +30,8 @@ class RvizUtils {
     createMarker(std::vector<geometry_msgs::Point> points,
                  visualization_msgs::Marker::_color_type color,
                  visualization_msgs::Marker::_scale_type scale,
-                 std::string frame_id,
-                 std::string ns,
+                 const std::string& frame_id,
+                 const std::string& ns,
                  int type = visualization_msgs::Marker::POINTS,
                  int id   = 0);
 
@@ -38,8 +39,8 @@ class RvizUtils {
      *  Turn points into a marker for rviz
      *  Can specify a color for each point
      *
-     *  @param points the points to be converted
-     *  @param colors the color of each point
+     *  @param points the points to be converted, moved into the marker
+     *  @param colors the color of each point, moved into the marker
      *  @param frame_id the frame id
      *  @param ns the namespace
      *
@@ -49,8 +50,8 @@ class RvizUtils {
     createMarker(std::vector<geometry_msgs::Point> points,
                  std::vector<std_msgs::ColorRGBA> colors,
                  visualization_msgs::Marker::_scale_type scale,
-                 std::string frame_id,
-                 std::string ns,
+                 const std::string& frame_id,
+                 const std::string& ns,
                  int type = visualization_msgs::Marker::POINTS,
                  int id   = 0);
 
@@ -68,15 +69,16 @@ class RvizUtils {
     createMarker(geometry_msgs::Point point,
                  std::vector<std_msgs::ColorRGBA> colors,
                  visualization_msgs::Marker::_scale_type scale,
-                 std::string frame_id,
-                 std::string ns,
+                 const std::string& frame_id,
+                 const std::string& ns,
                  int type = visualization_msgs::Marker::POINTS,
                  int id   = 0);
 
     /**
      * Creates a Marker Array (array of Markers)
      *
-     * @param points_array each array inside corresponds to one marker
+     * @param points_array each array inside corresponds to one marker,
+     * moved into its marker
      * @param color color of the points in the array
      * @param frame_id frame id of the markers
      * @param ns namespace of the markers
@@ -88,8 +90,8 @@ class RvizUtils {
     std::vector<std::vector<geometry_msgs::Point>> points_arary,
     visualization_msgs::Marker::_color_type color,
     visualization_msgs::Marker::_scale_type scale,
-    std::string frame_id,
-    std::string ns,
+    const std::string& frame_id,
+    const std::string& ns,
     int type = visualization_msgs::Marker::POINTS);
 
     /**
@@ -136,8 +138,8 @@ class RvizUtils {
      */
     static void setupMarker(visualization_msgs::Marker& marker,
                             visualization_msgs::Marker::_scale_type scale,
-                            std::string frame_id,
-                            std::string ns,
+                            const std::string& frame_id,
+                            const std::string& ns,
                             int type = visualization_msgs::Marker::POINTS,
                             int id   = 0);
 };
@@ -13,8 +13,8 @@ using namespace snowbots;
 Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
                                Marker::_color_type color,
                                Marker::_scale_type scale,
-                               string frame_id,
-                               string ns,
+                               const string& frame_id,
+                               const string& ns,
                                int type,
                                int id) {
     Marker marker;
@@ -25,7 +25,7 @@ Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
     marker.color = color;
 
     // Set the points
-    marker.points = points;
+    marker.points = std::move(points);
 
     return marker;
 }
@@ -33,8 +33,8 @@ Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
 Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
                                std::vector<std_msgs::ColorRGBA> colors,
                                Marker::_scale_type scale,
-                               string frame_id,
-                               string ns,
+                               const string& frame_id,
+                               const string& ns,
                                int type,
                                int id) {
     Marker marker;
@@ -42,10 +42,10 @@ Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
     setupMarker(marker, scale, frame_id, ns, type, id);
 
     // Set the colors
-    marker.colors = colors;
+    marker.colors = std::move(colors);
 
     // Set the points
-    marker.points = points;
+    marker.points = std::move(points);
 
     return marker;
 }
@@ -53,8 +53,8 @@ Marker RvizUtils::createMarker(vector<geometry_msgs::Point> points,
 Marker RvizUtils::createMarker(geometry_msgs::Point point,
                                std::vector<std_msgs::ColorRGBA> colors,
                                Marker::_scale_type scale,
-                               string frame_id,
-                               string ns,
+                               const string& frame_id,
+                               const string& ns,
                                int type,
                                int id) {
     Marker marker;
@@ -62,7 +62,7 @@ Marker RvizUtils::createMarker(geometry_msgs::Point point,
     setupMarker(marker, scale, frame_id, ns, type, id);
 
     // Set the color
-    marker.colors = colors;
+    marker.colors = std::move(colors);
 
     // Set the points
     marker.points.push_back(point);
@@ -74,14 +74,13 @@ MarkerArray
 RvizUtils::createMarkerArray(vector<vector<geometry_msgs::Point>> points_array,
                              Marker::_color_type color,
                              Marker::_scale_type scale,
-                             string frame_id,
-                             string ns,
+                             const string& frame_id,
+                             const string& ns,
                              int type) {
     visualization_msgs::MarkerArray markerArray;
     for (unsigned int i = 0; i < points_array.size(); i++) {
-        Marker marker =
-        createMarker(points_array[i], color, scale, frame_id, ns, type, i);
-        markerArray.markers.push_back(marker);
+        markerArray.markers.push_back(createMarker(
+        std::move(points_array[i]), color, scale, frame_id, ns, type, i));
     }
 
     return markerArray;
@@ -109,8 +108,8 @@ Marker::_scale_type RvizUtils::createrMarkerScale(float x, float y, float z) {
 
 void RvizUtils::setupMarker(Marker& marker,
                             visualization_msgs::Marker::_scale_type scale,
-                            std::string frame_id,
-                            std::string ns,
+                            const std::string& frame_id,
+                            const std::string& ns,
                             int type,
                             int id) {
     marker.header.stamp       = ros::Time::now();
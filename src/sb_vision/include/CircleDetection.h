@@ -46,6 +46,14 @@ class CircleDetection {
      */
     CircleDetection(int argc, char** argv, std::string node_name);
 
+    /**
+     * Constructor, for when ROS is already initialised, as in a nodelet
+     *
+     * @param nh the node handle to subscribe and publish with
+     * @param private_nh the node handle to get parameters from
+     */
+    CircleDetection(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     /**
      * Counts the number of circles found in the image.
      *
@@ -53,7 +61,33 @@ class CircleDetection {
      */
     int countCircles(const Mat& filtered_image, bool display_circles = true);
 
+    /**
+     * Sets whether to track the light rather than search every image for
+     * circles. When tracking, a smaller copy of the image is searched until
+     * a circle is found, after which only the region around it is searched,
+     * at full resolution, for as long as the circle stays there. Only the
+     * circles in that region are counted.
+     *
+     * @param tracking whether to track the light
+     * @param detection_scale how many times smaller the searched copy is
+     * @param roi_margin how far around the tracked circle to search, in
+     * radii of the circle
+     */
+    void
+    setTracking(bool tracking, int detection_scale = 4, float roi_margin = 1);
+
+    /**
+     * @return the region searched first in the next image, empty if nothing
+     * is being tracked
+     */
+    cv::Rect getTrackedROI() const { return tracked_roi; }
+
   private:
+    /**
+     * Sets up the subscriber and publisher, and gets the parameters
+     */
+    void setUpNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     /**
      * Callback for the filtered image
      *
@@ -62,18 +96,52 @@ class CircleDetection {
     void filteredImageCallBack(const sensor_msgs::Image::ConstPtr& image);
 
     /**
-     * Converts ros::sensor_msgs::Image into a cv::Mat
+     * Finds the objects of a binary image whose enclosing circle has a
+     * radius of at least @min_radius
      *
-     * @param message to be converted
+     * @param mode the contour retrieval mode, as in cv::findContours
+     * @param offset added to the centres found, for images that are part of
+     * a larger image
+     */
+    void findCircles(const Mat& bw_image,
+                     int mode,
+                     float min_radius,
+                     const cv::Point& offset,
+                     std::vector<cv::Point2f>& centers,
+                     std::vector<float>& radii);
+
+    /**
+     * Finds the circles around the tracked light, finding the light first if
+     * it isn't being tracked yet
      */
-    Mat rosToMat(const sensor_msgs::Image::ConstPtr& image);
+    void trackCircles(const Mat& bw_image,
+                      std::vector<cv::Point2f>& centers,
+                      std::vector<float>& radii);
+
+    /**
+     * Finds the circles in the tracked region at full resolution, and moves
+     * the region to follow the largest of them
+     *
+     * @return false, and stops tracking, if there are none
+     */
+    bool searchTrackedROI(const Mat& bw_image,
+                          std::vector<cv::Point2f>& centers,
+                          std::vector<float>& radii);
+
+    /**
+     * @return the region of an image of @image_size to search for a circle
+     * last seen at @center with @radius
+     */
+    cv::Rect getROI(const cv::Point2f& center,
+                    float radius,
+                    const cv::Size& image_size) const;
 
     /**
      *  Displays a window with the detected objects being circled
      */
     void showFilteredObjectsWindow(const Mat& filtered_image,
-                                   std::vector<cv::Point2i> center,
-                                   std::vector<float> radii);
+                                   const std::vector<cv::Point2i>& center,
+                                   const std::vector<float>& radii);
 
     /**
      * Determines whether path contains an image.
@@ -96,6 +164,17 @@ class CircleDetection {
 
     // Show window for debugging purposes
     bool show_window;
+
+    // Tracking the light, see setTracking
+    bool tracking;
+    int detection_scale;
+    float roi_margin;
+    cv::Rect tracked_roi;
+
+    // Reused between frames for colour images, and the smaller copy searched
+    // when tracking
+    cv::Mat gray_image;
+    cv::Mat small_image;
 };
 
 #endif
@@ -0,0 +1,128 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A bounded queue of frames between a single producer and a
+ *              single consumer. When it is full the oldest frame is dropped
+ *              to make room, so a slow consumer always works on the newest
+ *              frames and never falls further behind.
+ */
+
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+// STD
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+template <typename T> class FrameQueue {
+  public:
+    /**
+     * Constructor
+     *
+     * @param capacity the most frames the queue holds, at least 1
+     */
+    explicit FrameQueue(size_t capacity)
+      : slots(capacity > 0 ? capacity : 1),
+        head(0),
+        count(0),
+        num_dropped(0),
+        closed(false) {}
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+
+    /**
+     * Adds @frame to the back of the queue, dropping the frame at the front
+     * if the queue is full. Never blocks on the consumer.
+     *
+     * @return false if a frame was dropped, or the queue is closed
+     */
+    bool push(T frame) {
+        bool dropped = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) return false;
+            if (count == slots.size()) {
+                // The oldest frame is overwritten below
+                head    = (head + 1) % slots.size();
+                dropped = true;
+                count--;
+                num_dropped++;
+            }
+            slots[(head + count) % slots.size()] = std::move(frame);
+            count++;
+        }
+        condition.notify_one();
+        return !dropped;
+    }
+
+    /**
+     * Takes the frame at the front of the queue, waiting for one if it is
+     * empty
+     *
+     * @return false if the queue was closed, in which case @frame is unset
+     */
+    bool pop(T& frame) {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return closed || count > 0; });
+        if (closed) return false;
+
+        frame = std::move(slots[head]);
+        // Release anything the frame held on to, like image buffers
+        slots[head] = T();
+        head        = (head + 1) % slots.size();
+        count--;
+        return true;
+    }
+
+    /**
+     * Wakes the consumer and makes every later push and pop fail. Frames
+     * still queued are dropped.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            for (T& slot : slots) { slot = T(); }
+            count = 0;
+        }
+        condition.notify_all();
+    }
+
+    /**
+     * @return the number of frames waiting
+     */
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+    /**
+     * @return the most frames the queue holds
+     */
+    size_t capacity() const { return slots.size(); }
+
+    /**
+     * @return the number of frames dropped to make room for newer ones
+     */
+    uint64_t getNumDropped() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return num_dropped;
+    }
+
+  private:
+    // A ring of capacity frames, starting at head
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+    uint64_t num_dropped;
+    bool closed;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+#endif
@@ -8,13 +8,36 @@
  *			http://opencv-srf.blogspot.ca/2010/09/object-detection-using-color-seperation.html
  */
 
+#include <array>
 #include <iostream>
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <stdio.h>
+#include <vector>
 
 class HSVFilter {
+  public:
+    // How removeNoise cleans up the thresholded image
+    enum NoiseFilter {
+        // Opening with a 2x2 ellipse then closing with a 10x10 ellipse,
+        // five times over. The kernels have no centre pixel, so each pass
+        // also moves the mask by about a pixel down and right.
+        ITERATIVE,
+        // A single opening with a 3x3 ellipse then closing with an 11x11
+        // ellipse. Opening then closing again with the same centred kernels
+        // changes nothing, so this is what ITERATIVE converges to without
+        // moving the mask.
+        OPEN_CLOSE,
+        // OPEN_CLOSE with an 11x11 square for the closing, which is
+        // separable into a row and a column pass
+        RECT_OPEN_CLOSE,
+        // Removes foreground components smaller than min_component_area,
+        // and fills holes up to max_hole_area, by labelling components
+        COMPONENT_AREA
+    };
+
+  private:
     // Thresholds
     int _iLowH;
     int _iHighH;
@@ -26,6 +49,30 @@ class HSVFilter {
     cv::Mat rangeOutput;
     cv::Mat hsvOutput;
 
+    // Colour lookup table, one bit per BGR colour (b << 16 | g << 8 | r)
+    // saying whether it passes the thresholds it was built from
+    bool _useLUT;
+    std::vector<uchar> _lut;
+    std::array<int, 6> _lutThresholds;
+
+    // Noise removal, the kernels are only built once
+    NoiseFilter _noiseFilter;
+    cv::Mat _smallOpenKernel, _smallCloseKernel;
+    cv::Mat _openKernel, _closeKernel, _rectCloseKernel;
+    int _minComponentArea;
+    int _maxHoleArea;
+    cv::Mat _labels, _stats, _centroids;
+
+    // Horizontal stripes the image is filtered in, in parallel, and the
+    // buffers each one works in
+    class StripeFilter;
+    struct StripeBuffers {
+        cv::Mat hsv, mask;
+    };
+    int _numStripes;
+    std::vector<StripeBuffers> _stripes;
+    cv::Mat _noiseOutput;
+
     // Window Names
     std::string manualCalibrationWindow;
 
@@ -49,6 +96,73 @@ class HSVFilter {
      */
     void filterImage(const cv::Mat& input, cv::Mat& output);
 
+    /**
+     * Thresholds an image, without removing noise
+     *
+     * @param input the frame being thresholded
+     * @param output the binary image of the pixels within the thresholds
+     */
+    void threshold(const cv::Mat& input, cv::Mat& output);
+
+    /**
+     * Classify pixels with a lookup table of every BGR colour, instead of
+     * converting the whole frame to HSV. The table is 2 MB, and takes a few
+     * tens of milliseconds to build whenever the thresholds change.
+     *
+     * @param useLUT whether or not to use the lookup table
+     */
+    void setUseLUT(bool useLUT);
+
+    /**
+     * Removes small objects from, and fills small holes in, a binary image
+     *
+     * @param image the binary image to clean up in place
+     */
+    void removeNoise(cv::Mat& image);
+
+    /**
+     * Sets how removeNoise cleans up the thresholded image, ITERATIVE
+     * unless set
+     *
+     * @param noiseFilter the kind of clean up
+     * @param minComponentArea smallest object kept by COMPONENT_AREA, in
+     * pixels
+     * @param maxHoleArea largest hole filled by COMPONENT_AREA, in pixels
+     */
+    void setNoiseFilter(NoiseFilter noiseFilter,
+                        int minComponentArea = 20,
+                        int maxHoleArea      = 80);
+
+    /**
+     * Sets how many horizontal stripes filterImage and removeNoise split the
+     * image into, to filter them in parallel. Each stripe is filtered with
+     * enough rows either side of it for the result to be the same as
+     * filtering the whole image at once. COMPONENT_AREA always works on the
+     * whole image.
+     *
+     * @param numStripes the number of stripes, or 0 for one per OpenCV thread
+     */
+    void setNumStripes(int numStripes);
+
+    /**
+     * Reads a noise filter from its name, one of "iterative", "open_close",
+     * "rect_open_close" or "component_area"
+     *
+     * @return false if @name isn't one of them
+     */
+    static bool parseNoiseFilter(const std::string& name,
+                                 NoiseFilter& noiseFilter);
+
+    /**
+     * @return the lowest h, s and v values that pass the filter
+     */
+    cv::Scalar getLowerBound(void) const;
+
+    /**
+     * @return the highest h, s and v values that pass the filter
+     */
+    cv::Scalar getUpperBound(void) const;
+
     /**
      * Enables manual calibration of HSV values
      */
@@ -79,4 +193,39 @@ class HSVFilter {
      */
     void createFilter(
     int iLowH, int iHighH, int iLowS, int iHighS, int iLowV, int iHighV);
+
+    /**
+     * Rebuilds the lookup table if the thresholds changed since it was built
+     */
+    void updateLUT(void);
+
+    /**
+     * Removes noise with the morphological noise filters, which only look at
+     * a few rows either side of each pixel
+     */
+    void morphology(cv::Mat& image) const;
+
+    /**
+     * @return how many rows above or below a pixel the noise filter looks at,
+     * or -1 if it needs the whole image
+     */
+    int getNoiseHalo(void) const;
+
+    /**
+     * @return the number of stripes to filter an image of @rows rows in
+     */
+    int getNumStripes(int rows, int halo) const;
+
+    /**
+     * Sets the pixels of the components of @labels whose area is within
+     * [minArea, maxArea] to @value, ignoring components touching the border
+     * if @skipBorder
+     */
+    void setComponents(
+    cv::Mat& image, int minArea, int maxArea, bool skipBorder, uchar value);
+
+    /**
+     * @return the current thresholds, as lh, hh, ls, hs, lv, hv
+     */
+    std::array<int, 6> getThresholds(void) const;
 };
\ No newline at end of file
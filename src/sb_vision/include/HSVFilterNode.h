@@ -28,6 +28,7 @@
 #include <sensor_msgs/Image.h>
 
 // STD
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,10 @@
 
 // Snowbots
 #include <HSVFilter.h>
+#include <HSVIPMFilter.h>
+#include <IPMFilter.h>
+#include <ImageMessageBuffer.h>
+#include <VisionPipeline.h>
 #include <sb_utils.h>
 
 using namespace cv;
@@ -49,7 +54,28 @@ class HSVFilterNode {
      */
     HSVFilterNode(int argc, char** argv, std::string node_name);
 
+    /**
+     * Constructor, for when ROS is already initialised, as in a nodelet
+     *
+     * @param nh the node handle to subscribe and publish with
+     * @param private_nh the node handle to get parameters from
+     */
+    HSVFilterNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
   private:
+    // A frame on its way through the pipelined filter
+    struct PipelineFrame {
+        cv_bridge::CvImageConstPtr input;
+        // The message the frame is filtered into, and a header over its data
+        sensor_msgs::ImageConstPtr output;
+        cv::Mat mask;
+    };
+
+    /**
+     * Sets up the subscriber, publisher and filter
+     */
+    void setUpNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     /**
      * Callback for the filtered image
      *
@@ -62,6 +88,43 @@ class HSVFilterNode {
      */
     void setUpFilter();
 
+    /**
+     * Creates the fused HSV and IPM filter for images of
+     * image_width x image_height
+     */
+    void setUpIPM();
+
+    /**
+     * Creates the pipeline that thresholds, removes noise from and publishes
+     * frames on a thread per stage
+     *
+     * @param queue_size how many frames can wait for each stage
+     */
+    void setUpPipeline(int queue_size);
+
+    /**
+     * Pipeline stage thresholding a frame into the message to publish,
+     * applying IPM too if it is fused
+     *
+     * @return false if the frame can't be filtered
+     */
+    bool thresholdStage(PipelineFrame& frame);
+
+    /**
+     * Pipeline stage removing noise from the thresholded frame
+     */
+    bool noiseStage(PipelineFrame& frame);
+
+    /**
+     * Pipeline stage publishing the filtered frame
+     */
+    bool publishStage(PipelineFrame& frame);
+
+    /**
+     * Logs how each stage of the pipeline has been doing
+     */
+    void logPipelineStats();
+
     /**
      * Update filter values
      *
@@ -80,6 +143,9 @@ class HSVFilterNode {
      */
     Mat rosToMat(const sensor_msgs::Image::ConstPtr& image);
 
+    // Where parameters are read from
+    ros::NodeHandle private_nh;
+
     /**
      * Subscribes to the raw camera image node
      */
@@ -95,9 +161,13 @@ class HSVFilterNode {
     ros::Duration publish_interval;
 
     // Image processing Mat pipeline
+    cv_bridge::CvImageConstPtr inputImagePtr;
     cv::Mat imageInput;
     cv::Mat filterOutput;
 
+    // The published message, which the filter writes into
+    ImageMessageBuffer output_buffer;
+
     // The name and size of the display window
     std::string displayWindowName;
 
@@ -106,6 +176,15 @@ class HSVFilterNode {
     std::string mfilter_file;
     double frequency;
 
+    // Whether IPM is applied here, thresholding only the pixels the IPM image
+    // is made from, instead of by a separate IPM filter node
+    bool fuse_ipm;
+    IPMFilter* ipmFilter;
+    HSVIPMFilter* hsvIpmFilter;
+    float ipm_base_width, ipm_top_width, ipm_base_displacement,
+    ipm_top_displacement;
+    std::string ipm_cache_dir;
+
     // Whether or not we've received the first image
     bool receivedFirstImage;
 
@@ -113,6 +192,17 @@ class HSVFilterNode {
     int image_width, image_height;
     bool showWindow;
     bool isCalibratingManually;
+
+    // Whether frames go through a pipeline with a thread per stage, instead
+    // of being filtered in the callback. The noise stage has its own filter
+    // so the two stages don't share the filter's buffers.
+    bool pipelined;
+    HSVFilter noiseFilter;
+    ros::WallTime last_stats;
+    ros::WallDuration stats_interval;
+
+    // Last, so its threads are stopped before anything they use is destroyed
+    std::unique_ptr<VisionPipeline<PipelineFrame>> pipeline;
 };
 
 #endif
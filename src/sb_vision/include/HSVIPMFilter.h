@@ -0,0 +1,58 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Thresholds an image in the HSV colourspace and applies inverse
+ *              perspective mapping to it in a single pass, only looking at
+ *              the pixels the IPM image is made from.
+ */
+
+#ifndef HSV_IPM_FILTER_H
+#define HSV_IPM_FILTER_H
+
+// OpenCV
+#include <opencv2/core/core.hpp>
+
+// Objects
+#include <IPM.h>
+
+class HSVIPMFilter {
+  public:
+    /**
+     * Finds the pixels of the original image that the IPM image samples
+     *
+     * @param ipm the inverse perspective mapping to apply
+     */
+    explicit HSVIPMFilter(const IPM& ipm);
+
+    /**
+     * Builds the binary IPM image of @input, where a pixel is on if the
+     * colour of the original pixel nearest to where it samples is within
+     * [lower, upper] in the HSV colourspace. HSV values are the same as
+     * cv::cvtColor's for 8 bit images.
+     *
+     * @param input the BGR frame being filtered, of the original IPM size
+     * @param output the binary IPM image
+     * @param lower the lowest h, s and v values that pass the filter
+     * @param upper the highest h, s and v values that pass the filter
+     *
+     * @return false if @input isn't a BGR image of the original IPM size
+     */
+    bool filterImage(const cv::Mat& input,
+                     cv::Mat& output,
+                     const cv::Scalar& lower,
+                     const cv::Scalar& upper) const;
+
+    /**
+     * @return the number of pixels of the IPM image that sample inside the
+     * original image, the only ones that are thresholded
+     */
+    int getNumVisiblePixels() const { return num_visible_pixels; }
+
+  private:
+    // For each IPM pixel, the index of its original pixel, or -1
+    cv::Mat sources;
+    cv::Size source_size;
+    int num_visible_pixels;
+};
+
+#endif
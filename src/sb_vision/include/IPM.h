@@ -2,6 +2,8 @@
  * Inverse Perspective Mapping header file
  * Modified by: Valerian Ratu
  * 	- Added an empty constructor
+ * Modified by: agent
+ * 	- Fixed point remap tables, optionally cached on disk
  */
 
 #ifndef __IPM_H__
@@ -13,13 +15,18 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 #include <iostream>
+#include <string>
 
 class IPM {
   public:
+    // If _cacheDir is given, the remap tables are loaded from there when
+    // they were built before for the same sizes and points, and saved there
+    // otherwise
     IPM(const cv::Size& _origSize,
         const cv::Size& _dstSize,
         const std::vector<cv::Point2f>& _origPoints,
-        const std::vector<cv::Point2f>& _dstPoints);
+        const std::vector<cv::Point2f>& _dstPoints,
+        const std::string& _cacheDir = "");
 
     IPM();
 
@@ -40,9 +47,16 @@ class IPM {
     // Getters
     cv::Mat getH() const { return m_H; }
     cv::Mat getHinv() const { return m_H_inv; }
+    cv::Size getOrigSize() const { return m_origSize; }
+    cv::Size getDstSize() const { return m_dstSize; }
     void getPoints(std::vector<cv::Point2f>& _origPts,
                    std::vector<cv::Point2f>& _ipmPts);
 
+    // For each IPM pixel, the index (y * width + x) of the original pixel
+    // nearest to where it samples, or -1 if that is outside the original
+    // image, as a CV_32SC1 image
+    void getSourcePixels(cv::Mat& _sources) const;
+
     // Draw
     void drawPoints(const std::vector<cv::Point2f>& _points,
                     cv::Mat& _img) const;
@@ -50,6 +64,11 @@ class IPM {
   private:
     void createMaps();
 
+    // Remap table cache, named after a hash of the sizes and points
+    std::string cachePath(const std::string& _cacheDir) const;
+    bool loadMaps(const std::string& _path);
+    bool saveMaps(const std::string& _path) const;
+
     // Sizes
     cv::Size m_origSize;
     cv::Size m_dstSize;
@@ -61,9 +80,10 @@ class IPM {
     // Homography
     cv::Mat m_H;
     cv::Mat m_H_inv;
-    // Maps
-    cv::Mat m_mapX, m_mapY;
-    cv::Mat m_invMapX, m_invMapY;
+    // Maps, in the fixed point format of cv::convertMaps (CV_16SC2 integer
+    // coordinates and CV_16UC1 interpolation table indices)
+    cv::Mat m_map1, m_map2;
+    cv::Mat m_invMap1, m_invMap2;
 };
 
 #endif /*__IPM_H__*/
\ No newline at end of file
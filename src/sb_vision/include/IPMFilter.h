@@ -32,13 +32,17 @@ class IPMFilter {
   public:
     /**
      * Initializes the corners of the filter
+     *
+     * @param cache_dir where the IPM maps are cached, empty to always
+     * build them
      */
     IPMFilter(float ipm_base_width,
               float ipm_top_width,
               float ipm_base_displacement,
               float ipm_top_displacement,
               float image_height,
-              float image_width);
+              float image_width,
+              const std::string& cache_dir = "");
 
     /**
      * Filters an image according to ipm
@@ -48,6 +52,11 @@ class IPMFilter {
      */
     void filterImage(const cv::Mat& input, cv::Mat& output);
 
+    /**
+     * @return the IPM transformer used by the filter
+     */
+    const IPM& getIPM() const { return ipm; }
+
   private:
     /**
      * Initializator
@@ -59,7 +68,8 @@ class IPMFilter {
                       float ipm_base_displacement,
                       float ipm_top_displacement,
                       float image_height,
-                      float image_width);
+                      float image_width,
+                      const std::string& cache_dir);
 
     // Corners of the portion of the image to be filtered
     int x1, y1;
@@ -69,6 +79,7 @@ class IPMFilter {
 
     // Filters and their variables
     IPM ipm;
+    cv::Mat workingImage;
     std::vector<cv::Point2f> orig_points;
     std::vector<cv::Point2f> dst_points;
 };
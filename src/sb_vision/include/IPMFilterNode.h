@@ -38,6 +38,7 @@
 
 // Snowbots
 #include <IPMFilter.h>
+#include <ImageMessageBuffer.h>
 #include <sb_utils.h>
 
 using namespace cv;
@@ -54,7 +55,21 @@ class IPMFilterNode {
      */
     IPMFilterNode(int argc, char** argv, std::string node_name);
 
+    /**
+     * Constructor, for when ROS is already initialised, as in a nodelet
+     *
+     * @param nh the node handle to subscribe and publish with
+     * @param private_nh the node handle to get parameters from
+     */
+    IPMFilterNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
   private:
+    /**
+     * Sets up the subscriber, publisher and, if the image size is known,
+     * the filter
+     */
+    void setUpNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh);
+
     /**
      * Callback for the filtered image
      *
@@ -63,11 +78,9 @@ class IPMFilterNode {
     void filteredImageCallBack(const sensor_msgs::Image::ConstPtr& image);
 
     /**
-     * Converts ros::sensor_msgs::Image into a cv::Mat
-     *
-     * @param message to be converted
+     * Creates the IPM filter for images of image_width x image_height
      */
-    Mat rosToMat(const sensor_msgs::Image::ConstPtr& image);
+    void createIPMFilter();
 
     /**
      * Subscribes to the raw camera image node
@@ -79,6 +92,9 @@ class IPMFilterNode {
      */
     image_transport::Publisher ipm_filter_pub;
 
+    // The published message, which the filter writes into
+    ImageMessageBuffer output_buffer;
+
     // Whether or not we've received the first image
     bool receivedFirstImage;
 
@@ -87,6 +103,7 @@ class IPMFilterNode {
 
     // IPM Filter Variables
     IPMFilter* ipmFilter;
+    std::string ipm_cache_dir;
     float ipm_base_width, ipm_top_width, ipm_base_displacement,
     ipm_top_displacement;
 };
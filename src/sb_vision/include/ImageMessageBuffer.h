@@ -0,0 +1,68 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: An image message that is reused from frame to frame, so that
+ *              nodes can filter straight into the message they publish
+ *              instead of allocating and copying into a new one each time.
+ */
+
+#ifndef IMAGE_MESSAGE_BUFFER_H
+#define IMAGE_MESSAGE_BUFFER_H
+
+// OpenCV
+#include <opencv2/core/core.hpp>
+
+// ROS
+#include <sensor_msgs/Image.h>
+
+// STD
+#include <string>
+#include <vector>
+
+class ImageMessageBuffer {
+  public:
+    /**
+     * Constructor
+     *
+     * @param max_messages how many messages to keep for reuse, enough for
+     * every frame that can be in use at once
+     */
+    explicit ImageMessageBuffer(size_t max_messages = 4);
+
+    /**
+     * Gets the message for the next frame ready. A kept message is reused
+     * if nothing else holds on to it any more, which it may if it was
+     * published to a subscriber in the same process or is still being
+     * worked on. Otherwise a new message is allocated.
+     *
+     * @param header the header of the next frame
+     * @param size the size of the next frame
+     * @param encoding the encoding of the next frame, as in
+     * sensor_msgs::image_encodings
+     *
+     * @return a header over the data of the message, to write the frame into
+     */
+    cv::Mat next(const std_msgs::Header& header,
+                 const cv::Size& size,
+                 const std::string& encoding);
+
+    /**
+     * @return the message of the last frame, to be published
+     */
+    sensor_msgs::ImageConstPtr message() const { return messages[current]; }
+
+    /**
+     * @return how many messages have been allocated, for testing
+     */
+    unsigned int getNumAllocations() const { return num_allocations; }
+
+  private:
+    size_t max_messages;
+    std::vector<sensor_msgs::ImagePtr> messages;
+    // The last frame's message, and the one replaced next if none are free
+    size_t current;
+    size_t oldest;
+    unsigned int num_allocations;
+};
+
+#endif
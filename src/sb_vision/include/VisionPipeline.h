@@ -0,0 +1,232 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Runs each stage of a vision pipeline on its own thread, with a
+ *              bounded queue in front of each stage that drops its oldest
+ *              frame when full. Frames move through the stages in order,
+ *              but while one stage works on a frame the stage before it can
+ *              already start on the next, so throughput is set by the
+ *              slowest stage instead of the sum of them, and a slow stage
+ *              only ever has queue_capacity frames waiting for it.
+ */
+
+#ifndef VISION_PIPELINE_H
+#define VISION_PIPELINE_H
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Snowbots
+#include <FrameQueue.h>
+
+template <typename Frame> class VisionPipeline {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Processes a frame in place
+     *
+     * @return false to drop the frame instead of passing it on
+     */
+    typedef std::function<bool(Frame&)> Stage;
+
+    // How a stage has been doing since the stats were last taken
+    struct StageStats {
+        std::string name;
+        // Frames the stage finished
+        uint64_t processed;
+        // Frames dropped from the stage's queue to make room for newer ones,
+        // or by the stage itself
+        uint64_t dropped;
+        // Frames waiting for the stage right now
+        size_t queued;
+        // Fraction of the time the stage was busy, near 1 for the stage
+        // holding the rest up
+        double occupancy;
+        // Mean time frames waited for the stage, in milliseconds
+        double wait_ms;
+        // Mean time the stage took per frame, in milliseconds
+        double process_ms;
+        // Mean time from a frame being pushed to the stage finishing it, in
+        // milliseconds
+        double latency_ms;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param queue_capacity how many frames can wait for each stage
+     */
+    explicit VisionPipeline(size_t queue_capacity = 1)
+      : queue_capacity(queue_capacity), running(false) {}
+
+    /**
+     * Stops the pipeline, dropping the frames in it
+     */
+    ~VisionPipeline() { stop(); }
+
+    VisionPipeline(const VisionPipeline&) = delete;
+    VisionPipeline& operator=(const VisionPipeline&) = delete;
+
+    /**
+     * Adds a stage after the ones already added. Stages can't be added once
+     * the pipeline is started.
+     *
+     * @param name what the stage is called in the stats
+     * @param stage what the stage does to each frame
+     */
+    void addStage(const std::string& name, Stage stage) {
+        if (running) return;
+        std::unique_ptr<StageState> state(new StageState(queue_capacity));
+        state->name    = name;
+        state->process = stage;
+        stages.push_back(std::move(state));
+    }
+
+    /**
+     * Starts a thread for each stage
+     */
+    void start() {
+        if (running || stages.empty()) return;
+        running = true;
+        for (size_t i = 0; i < stages.size(); i++) {
+            stages[i]->stats_since = Clock::now();
+            stages[i]->worker      = std::thread(&VisionPipeline::run, this, i);
+        }
+    }
+
+    /**
+     * Stops every stage, once they finish the frame they are working on,
+     * and drops the frames still queued
+     */
+    void stop() {
+        if (!running) return;
+        for (auto& stage : stages) { stage->input.close(); }
+        for (auto& stage : stages) { stage->worker.join(); }
+        running = false;
+    }
+
+    /**
+     * Queues @frame for the first stage, without waiting for it
+     *
+     * @return false if a frame had to be dropped, or the pipeline isn't
+     * running
+     */
+    bool push(Frame frame) {
+        if (!running) return false;
+        Envelope envelope;
+        envelope.frame    = std::move(frame);
+        envelope.pushed   = Clock::now();
+        envelope.enqueued = envelope.pushed;
+        return stages.front()->input.push(std::move(envelope));
+    }
+
+    /**
+     * @return how each stage has been doing since the last call
+     */
+    std::vector<StageStats> getStats() {
+        std::vector<StageStats> all_stats;
+        Clock::time_point now = Clock::now();
+        for (auto& stage : stages) {
+            uint64_t num_dropped = stage->input.getNumDropped();
+
+            std::lock_guard<std::mutex> lock(stage->stats_mutex);
+            StageStats stats;
+            stats.name      = stage->name;
+            stats.processed = stage->processed;
+            stats.dropped =
+            num_dropped - stage->last_num_dropped + stage->rejected;
+            stats.queued = stage->input.size();
+
+            double elapsed =
+            std::chrono::duration<double>(now - stage->stats_since).count();
+            double frames    = stage->processed > 0 ? stage->processed : 1;
+            stats.occupancy  = elapsed > 0 ? stage->process_time / elapsed : 0;
+            stats.wait_ms    = 1000 * stage->wait_time / frames;
+            stats.process_ms = 1000 * stage->process_time / frames;
+            stats.latency_ms = 1000 * stage->latency / frames;
+            all_stats.push_back(stats);
+
+            stage->processed        = 0;
+            stage->rejected         = 0;
+            stage->last_num_dropped = num_dropped;
+            stage->wait_time        = 0;
+            stage->process_time     = 0;
+            stage->latency          = 0;
+            stage->stats_since      = now;
+        }
+        return all_stats;
+    }
+
+  private:
+    // A frame, and when it entered the pipeline and its current queue
+    struct Envelope {
+        Frame frame;
+        Clock::time_point pushed;
+        Clock::time_point enqueued;
+    };
+
+    struct StageState {
+        explicit StageState(size_t capacity) : input(capacity) {}
+
+        std::string name;
+        Stage process;
+        FrameQueue<Envelope> input;
+        std::thread worker;
+
+        // Stats since stats_since, times in seconds
+        std::mutex stats_mutex;
+        Clock::time_point stats_since;
+        uint64_t processed        = 0;
+        uint64_t rejected         = 0;
+        uint64_t last_num_dropped = 0;
+        double wait_time          = 0;
+        double process_time       = 0;
+        double latency            = 0;
+    };
+
+    void run(size_t index) {
+        StageState& stage = *stages[index];
+        Envelope envelope;
+        while (stage.input.pop(envelope)) {
+            Clock::time_point start = Clock::now();
+            bool keep               = stage.process(envelope.frame);
+            Clock::time_point end   = Clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(stage.stats_mutex);
+                stage.processed++;
+                if (!keep) stage.rejected++;
+                stage.wait_time += seconds(start - envelope.enqueued);
+                stage.process_time += seconds(end - start);
+                stage.latency += seconds(end - envelope.pushed);
+            }
+
+            if (keep && index + 1 < stages.size()) {
+                envelope.enqueued = end;
+                stages[index + 1]->input.push(std::move(envelope));
+            }
+            // Let go of the frame's buffers before waiting for the next one
+            envelope = Envelope();
+        }
+    }
+
+    static double seconds(Clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    size_t queue_capacity;
+    // Read by whichever thread pushes frames
+    std::atomic<bool> running;
+    std::vector<std::unique_ptr<StageState>> stages;
+};
+
+#endif
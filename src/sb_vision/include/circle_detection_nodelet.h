@@ -0,0 +1,39 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which detects circles, like a lit
+ *              stoplight, in a filtered image.
+ *              Runs CircleDetection inside a nodelet manager, so filtered
+ *              images arrive without being serialised or copied.
+ */
+
+#ifndef SB_VISION_CIRCLE_DETECTION_NODELET_H
+#define SB_VISION_CIRCLE_DETECTION_NODELET_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+
+#include <CircleDetection.h>
+
+namespace sb_vision {
+
+class CircleDetectionNodelet : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    CircleDetectionNodelet();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    // Does all the work, set up with the nodelet's node handles
+    boost::shared_ptr<CircleDetection> circle_detection;
+};
+}
+
+#endif // SB_VISION_CIRCLE_DETECTION_NODELET_H
@@ -0,0 +1,39 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which filters an image in the HSV colourspace
+ *              to a binary image.
+ *              Runs HSVFilterNode inside a nodelet manager, so its images
+ *              reach the other vision nodelets without being serialised.
+ */
+
+#ifndef SB_VISION_HSV_FILTER_NODELET_H
+#define SB_VISION_HSV_FILTER_NODELET_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+
+#include <HSVFilterNode.h>
+
+namespace sb_vision {
+
+class HSVFilterNodelet : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    HSVFilterNodelet();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    // Does all the work, set up with the nodelet's node handles
+    boost::shared_ptr<HSVFilterNode> hsv_filter;
+};
+}
+
+#endif // SB_VISION_HSV_FILTER_NODELET_H
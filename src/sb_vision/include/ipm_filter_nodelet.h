@@ -0,0 +1,39 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which applies inverse perspective mapping to
+ *              a filtered image.
+ *              Runs IPMFilterNode inside a nodelet manager, so filtered
+ *              images arrive without being serialised or copied.
+ */
+
+#ifndef SB_VISION_IPM_FILTER_NODELET_H
+#define SB_VISION_IPM_FILTER_NODELET_H
+
+// ROS Includes
+#include <nodelet/nodelet.h>
+#include <ros/ros.h>
+
+#include <IPMFilterNode.h>
+
+namespace sb_vision {
+
+class IPMFilterNodelet : public nodelet::Nodelet {
+  public:
+    /**
+     * Empty constructor
+     */
+    IPMFilterNodelet();
+
+  private:
+    /**
+     * Initializes the nodelet
+     */
+    virtual void onInit();
+
+    // Does all the work, set up with the nodelet's node handles
+    boost::shared_ptr<IPMFilterNode> ipm_filter;
+};
+}
+
+#endif // SB_VISION_IPM_FILTER_NODELET_H
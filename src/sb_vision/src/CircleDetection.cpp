@@ -14,6 +14,28 @@ using namespace cv;
 using namespace std;
 using namespace cv_bridge;
 
+namespace {
+// Fits the smallest enclosing circle to each of a range of contours
+class CircleFitter : public ParallelLoopBody {
+  public:
+    CircleFitter(const vector<vector<Point>>& contours,
+                 vector<Point2f>& centers,
+                 vector<float>& radii)
+      : contours(contours), centers(centers), radii(radii) {}
+
+    void operator()(const Range& range) const override {
+        for (int i = range.start; i < range.end; i++) {
+            minEnclosingCircle(contours[i], centers[i], radii[i]);
+        }
+    }
+
+  private:
+    const vector<vector<Point>>& contours;
+    vector<Point2f>& centers;
+    vector<float>& radii;
+};
+} // namespace
+
 CircleDetection::CircleDetection(std::string& image_path) {
     cv::Mat bgr_image = imread(image_path);
 
@@ -21,6 +43,7 @@ CircleDetection::CircleDetection(std::string& image_path) {
     checkIfImageExists(bgr_image, image_path);
 
     min_target_radius = 20;
+    tracking          = false;
     countCircles(bgr_image);
 
     waitKey(0);
@@ -28,6 +51,7 @@ CircleDetection::CircleDetection(std::string& image_path) {
 
 CircleDetection::CircleDetection() {
     min_target_radius = 20;
+    tracking          = false;
 }
 
 CircleDetection::CircleDetection(int argc, char** argv, std::string node_name) {
@@ -36,6 +60,22 @@ CircleDetection::CircleDetection(int argc, char** argv, std::string node_name) {
     ros::NodeHandle nh;
     ros::NodeHandle private_nh("~");
 
+    // Threads the contours are fitted on, 0 for one per core. Only read when
+    // running on its own, since the count is shared by the whole process.
+    int num_threads;
+    SB_getParam(private_nh, "num_threads", num_threads, 0);
+    if (num_threads > 0) cv::setNumThreads(num_threads);
+
+    setUpNode(nh, private_nh);
+}
+
+CircleDetection::CircleDetection(ros::NodeHandle& nh,
+                                 ros::NodeHandle& private_nh) {
+    setUpNode(nh, private_nh);
+}
+
+void CircleDetection::setUpNode(ros::NodeHandle& nh,
+                                ros::NodeHandle& private_nh) {
     // Setup image transport
     image_transport::ImageTransport it(nh);
 
@@ -53,27 +93,31 @@ CircleDetection::CircleDetection(int argc, char** argv, std::string node_name) {
     // Get some params
     SB_getParam(private_nh, "minimum_target_radius", min_target_radius, 50);
     SB_getParam(private_nh, "show_image_window", show_window, true);
+
+    // Track the light instead of searching every image for it
+    bool track_light;
+    int scale;
+    float margin;
+    SB_getParam(private_nh, "track_light", track_light, false);
+    SB_getParam(private_nh, "detection_scale", scale, 4);
+    SB_getParam(private_nh, "roi_margin", margin, (float) 1);
+    setTracking(track_light, scale, margin);
 }
 
 void CircleDetection::filteredImageCallBack(
 const sensor_msgs::Image::ConstPtr& image) {
+    // Shares the message's data, which stays alive as long as the pointer
+    CvImageConstPtr image_ptr = toCvShare(image, image->encoding);
+
     // If something is seen tell the robot to move
-    int num_circles = countCircles(rosToMat(image));
+    int num_circles = countCircles(image_ptr->image, show_window);
     std_msgs::Bool circle_detected;
     circle_detected.data = num_circles > 0;
     activity_publisher.publish(circle_detected);
 }
 
-Mat CircleDetection::rosToMat(const sensor_msgs::Image::ConstPtr& image) {
-    CvImagePtr image_ptr;
-    image_ptr = toCvCopy(image, image->encoding);
-    return image_ptr->image;
-}
-
 int CircleDetection::countCircles(const Mat& filtered_image,
                                   bool display_circles) {
-    vector<vector<Point>> contours;
-    vector<Vec4i> hierarchy;
     vector<cv::Point2i> center;
     vector<float> radii;
 
@@ -81,28 +125,29 @@ int CircleDetection::countCircles(const Mat& filtered_image,
     cv::Mat bwImage;
     switch (filtered_image.channels()) {
         // 4 channel and 3 channel conversion should cover all our use cases.
-        case 4: cvtColor(filtered_image, bwImage, CV_BGRA2GRAY); break;
-        case 3: cvtColor(filtered_image, bwImage, CV_BGR2GRAY); break;
+        case 4:
+            cvtColor(filtered_image, gray_image, CV_BGRA2GRAY);
+            bwImage = gray_image;
+            break;
+        case 3:
+            cvtColor(filtered_image, gray_image, CV_BGR2GRAY);
+            bwImage = gray_image;
+            break;
         default: bwImage = filtered_image;
     }
 
-    // Find contours of the black and white image
-    cv::findContours(
-    bwImage.clone(), contours, hierarchy, CV_RETR_TREE, CV_CHAIN_APPROX_NONE);
-
-    size_t count = contours.size();
-
-    for (int i = 0; i < count; i++) {
-        cv::Point2f c;
-        float r;
-        cv::minEnclosingCircle(contours[i], c, r);
-
-        // Only count circles with large enough radius
-        if (r >= min_target_radius) {
-            center.push_back(c);
-            radii.push_back(r);
-        }
+    vector<cv::Point2f> circle_centers;
+    if (tracking) {
+        trackCircles(bwImage, circle_centers, radii);
+    } else {
+        findCircles(bwImage,
+                    CV_RETR_TREE,
+                    min_target_radius,
+                    cv::Point(),
+                    circle_centers,
+                    radii);
     }
+    center.assign(circle_centers.begin(), circle_centers.end());
 
     if (display_circles) {
         // Displays a window with the detected objects being circled
@@ -114,9 +159,135 @@ int CircleDetection::countCircles(const Mat& filtered_image,
     return (int) center.size();
 }
 
-void CircleDetection::showFilteredObjectsWindow(const Mat& filtered_image,
-                                                std::vector<cv::Point2i> center,
-                                                std::vector<float> radii) {
+void CircleDetection::setTracking(bool tracking,
+                                  int detection_scale,
+                                  float roi_margin) {
+    this->tracking        = tracking;
+    this->detection_scale = std::max(1, std::min(detection_scale, 8));
+    this->roi_margin      = std::max(0.5f, roi_margin);
+    tracked_roi           = cv::Rect();
+}
+
+void CircleDetection::findCircles(const Mat& bw_image,
+                                  int mode,
+                                  float min_radius,
+                                  const cv::Point& offset,
+                                  vector<cv::Point2f>& centers,
+                                  vector<float>& radii) {
+    // Find contours of the black and white image, which OpenCV only writes
+    // over before 3.2. Only the corners of each contour are kept, which
+    // doesn't change the circle enclosing it.
+    vector<vector<Point>> contours;
+    cv::Mat contourImage = bw_image;
+#if CV_VERSION_MAJOR < 3 || (CV_VERSION_MAJOR == 3 && CV_VERSION_MINOR < 2)
+    contourImage = bw_image.clone();
+#endif
+    cv::findContours(
+    contourImage, contours, mode, CV_CHAIN_APPROX_SIMPLE, offset);
+
+    // A contour's enclosing circle is no larger than the one around its
+    // bounding box, so specks can be skipped without fitting them
+    vector<vector<Point>> candidates;
+    for (vector<Point>& contour : contours) {
+        cv::Rect box = boundingRect(contour);
+        if (box.width * box.width + box.height * box.height >=
+            4 * min_radius * min_radius) {
+            candidates.push_back(std::move(contour));
+        }
+    }
+
+    size_t count = candidates.size();
+
+    // Finding the contours has to follow them around the whole image, but
+    // each one can be fitted on its own
+    vector<cv::Point2f> contour_centers(count);
+    vector<float> contour_radii(count);
+    parallel_for_(Range(0, (int) count),
+                  CircleFitter(candidates, contour_centers, contour_radii));
+
+    for (int i = 0; i < count; i++) {
+        // Only count circles with large enough radius
+        if (contour_radii[i] >= min_radius) {
+            centers.push_back(contour_centers[i]);
+            radii.push_back(contour_radii[i]);
+        }
+    }
+}
+
+void CircleDetection::trackCircles(const Mat& bw_image,
+                                   vector<cv::Point2f>& centers,
+                                   vector<float>& radii) {
+    // Look where the light was last seen
+    if (tracked_roi.area() > 0 && searchTrackedROI(bw_image, centers, radii)) {
+        return;
+    }
+
+    // Otherwise look for it in a smaller copy of the image. Averaging keeps
+    // every object, but can shrink it by up to a pixel of the copy.
+    double scale = 1.0 / detection_scale;
+    resize(bw_image, small_image, cv::Size(), scale, scale, INTER_AREA);
+    vector<cv::Point2f> small_centers;
+    vector<float> small_radii;
+    findCircles(small_image,
+                CV_RETR_EXTERNAL,
+                min_target_radius * scale - 1,
+                cv::Point(),
+                small_centers,
+                small_radii);
+
+    // Check the candidates at full resolution, largest first, until one of
+    // them is the light
+    vector<size_t> order(small_radii.size());
+    for (size_t i = 0; i < order.size(); i++) { order[i] = i; }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return small_radii[a] > small_radii[b];
+    });
+    for (size_t i : order) {
+        cv::Point2f center =
+        (small_centers[i] + cv::Point2f(0.5f, 0.5f)) * (float) detection_scale -
+        cv::Point2f(0.5f, 0.5f);
+        float radius = (small_radii[i] + 1) * detection_scale;
+        tracked_roi  = getROI(center, radius, bw_image.size());
+        if (searchTrackedROI(bw_image, centers, radii)) return;
+    }
+}
+
+bool CircleDetection::searchTrackedROI(const Mat& bw_image,
+                                       vector<cv::Point2f>& centers,
+                                       vector<float>& radii) {
+    findCircles(bw_image(tracked_roi),
+                CV_RETR_EXTERNAL,
+                min_target_radius,
+                tracked_roi.tl(),
+                centers,
+                radii);
+    if (centers.empty()) {
+        tracked_roi = cv::Rect();
+        return false;
+    }
+
+    // Follow the largest circle, in case the light moved
+    size_t largest =
+    std::max_element(radii.begin(), radii.end()) - radii.begin();
+    tracked_roi = getROI(centers[largest], radii[largest], bw_image.size());
+    return true;
+}
+
+cv::Rect CircleDetection::getROI(const cv::Point2f& center,
+                                 float radius,
+                                 const cv::Size& image_size) const {
+    int half_size = cvCeil(radius * (1 + roi_margin));
+    cv::Rect roi(cvFloor(center.x) - half_size,
+                 cvFloor(center.y) - half_size,
+                 2 * half_size + 1,
+                 2 * half_size + 1);
+    return roi & cv::Rect(cv::Point(), image_size);
+}
+
+void CircleDetection::showFilteredObjectsWindow(
+const Mat& filtered_image,
+const std::vector<cv::Point2i>& center,
+const std::vector<float>& radii) {
     size_t center_count = center.size();
     cv::Scalar green(0, 255, 0);
     cv::Mat color_image;
@@ -9,6 +9,132 @@
  */
 
 #include <HSVFilter.h>
+#include <algorithm>
+
+namespace {
+// Determines how many times ITERATIVE erodes then dilates
+const int ITERATIVE_PASSES = 5;
+
+// Builds the lookup table entries of every colour with a given blue value at
+// a time, using cvtColor itself so the table agrees with it exactly
+class LUTBuilder : public cv::ParallelLoopBody {
+  public:
+    LUTBuilder(std::vector<uchar>& lut,
+               const cv::Scalar& lower,
+               const cv::Scalar& upper)
+      : lut(lut), lower(lower), upper(upper) {}
+
+    void operator()(const cv::Range& blues) const override {
+        // Every green (rows) and red (columns) for one blue
+        cv::Mat colours(256, 256, CV_8UC3), hsv, passes;
+        for (int b = blues.start; b < blues.end; b++) {
+            for (int g = 0; g < 256; g++) {
+                cv::Vec3b* row = colours.ptr<cv::Vec3b>(g);
+                for (int r = 0; r < 256; r++) { row[r] = cv::Vec3b(b, g, r); }
+            }
+            cv::cvtColor(colours, hsv, CV_BGR2HSV, 0);
+            cv::inRange(hsv, lower, upper, passes);
+
+            // Pack the 256 * 256 results into bits
+            const uchar* pass = passes.ptr<uchar>();
+            uchar* bits       = &lut[b << 13];
+            for (int i = 0; i < 256 * 256 / 8; i++, pass += 8) {
+                uchar byte = 0;
+                for (int bit = 0; bit < 8; bit++) {
+                    if (pass[bit]) byte |= 1 << bit;
+                }
+                bits[i] = byte;
+            }
+        }
+    }
+
+  private:
+    std::vector<uchar>& lut;
+    cv::Scalar lower, upper;
+};
+
+// Classifies a band of rows of a BGR image with the lookup table
+class LUTClassifier : public cv::ParallelLoopBody {
+  public:
+    LUTClassifier(const cv::Mat& input,
+                  cv::Mat& output,
+                  const std::vector<uchar>& lut)
+      : input(input), output(output), lut(lut) {}
+
+    void operator()(const cv::Range& rows) const override {
+        const uchar* bits = lut.data();
+        for (int j = rows.start; j < rows.end; j++) {
+            const uchar* bgr = input.ptr<uchar>(j);
+            uchar* out       = output.ptr<uchar>(j);
+            for (int i = 0; i < input.cols; i++, bgr += 3) {
+                int colour = bgr[0] << 16 | bgr[1] << 8 | bgr[2];
+                out[i]     = (bits[colour >> 3] >> (colour & 7)) & 1 ? 255 : 0;
+            }
+        }
+    }
+
+  private:
+    const cv::Mat& input;
+    cv::Mat& output;
+    const std::vector<uchar>& lut;
+};
+} // namespace
+
+// Thresholds and removes noise from a set of horizontal stripes of an image.
+// Each stripe is filtered along with halo rows either side of it, which are
+// then thrown away, so that the morphology near the edges of the stripe sees
+// the same neighbours it would in the whole image.
+class HSVFilter::StripeFilter : public cv::ParallelLoopBody {
+  public:
+    StripeFilter(HSVFilter& filter,
+                 const cv::Mat& input,
+                 cv::Mat& output,
+                 int halo,
+                 bool threshold)
+      : filter(filter),
+        input(input),
+        output(output),
+        halo(halo),
+        threshold(threshold) {}
+
+    void operator()(const cv::Range& stripes) const override {
+        int numStripes = static_cast<int>(filter._stripes.size());
+        for (int s = stripes.start; s < stripes.end; s++) {
+            int start  = input.rows * s / numStripes;
+            int end    = input.rows * (s + 1) / numStripes;
+            int top    = std::max(0, start - halo);
+            int bottom = std::min(input.rows, end + halo);
+
+            StripeBuffers& buffers = filter._stripes[s];
+            cv::Mat rows           = input.rowRange(top, bottom);
+            if (!threshold) {
+                rows.copyTo(buffers.mask);
+            } else if (filter._useLUT && rows.type() == CV_8UC3) {
+                buffers.mask.create(rows.size(), CV_8UC1);
+                LUTClassifier(rows, buffers.mask, filter._lut)(
+                cv::Range(0, rows.rows));
+            } else {
+                cv::cvtColor(rows, buffers.hsv, CV_BGR2HSV, 0);
+                cv::inRange(buffers.hsv,
+                            filter.getLowerBound(),
+                            filter.getUpperBound(),
+                            buffers.mask);
+            }
+
+            filter.morphology(buffers.mask);
+
+            cv::Mat stripe = output.rowRange(start, end);
+            buffers.mask.rowRange(start - top, end - top).copyTo(stripe);
+        }
+    }
+
+  private:
+    HSVFilter& filter;
+    const cv::Mat& input;
+    cv::Mat& output;
+    int halo;
+    bool threshold;
+};
 
 // Two different constructors
 HSVFilter::HSVFilter() {
@@ -31,6 +157,52 @@ int iLowH, int iHighH, int iLowS, int iHighS, int iLowV, int iHighV) {
     _iLowV                  = iLowV;
     _iHighV                 = iHighV;
     manualCalibrationWindow = "Manual Calibration";
+    _useLUT                 = false;
+    _numStripes             = 0;
+
+    _smallOpenKernel = getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(2, 2));
+    _smallCloseKernel =
+    getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(10, 10));
+    _openKernel  = getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3));
+    _closeKernel = getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(11, 11));
+    _rectCloseKernel = getStructuringElement(cv::MORPH_RECT, cv::Size(11, 11));
+    setNoiseFilter(ITERATIVE);
+}
+
+void HSVFilter::setNoiseFilter(NoiseFilter noiseFilter,
+                               int minComponentArea,
+                               int maxHoleArea) {
+    _noiseFilter      = noiseFilter;
+    _minComponentArea = minComponentArea;
+    _maxHoleArea      = maxHoleArea;
+}
+
+bool HSVFilter::parseNoiseFilter(const std::string& name,
+                                 NoiseFilter& noiseFilter) {
+    if (name == "iterative") {
+        noiseFilter = ITERATIVE;
+    } else if (name == "open_close") {
+        noiseFilter = OPEN_CLOSE;
+    } else if (name == "rect_open_close") {
+        noiseFilter = RECT_OPEN_CLOSE;
+    } else if (name == "component_area") {
+        noiseFilter = COMPONENT_AREA;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void HSVFilter::setNumStripes(int numStripes) {
+    _numStripes = std::max(0, numStripes);
+}
+
+void HSVFilter::setUseLUT(bool useLUT) {
+    _useLUT = useLUT;
+    if (!_useLUT) {
+        // Free the table
+        std::vector<uchar>().swap(_lut);
+    }
 }
 
 // Functions
@@ -54,34 +226,168 @@ void HSVFilter::stopManualCalibration() {
 }
 
 void HSVFilter::filterImage(const cv::Mat& input, cv::Mat& output) {
-    cv::cvtColor(input, hsvOutput, CV_BGR2HSV, 0);
-    cv::inRange(hsvOutput,
-                cv::Scalar(_iLowH, _iLowS, _iLowV),
-                cv::Scalar(_iHighH, _iHighS, _iHighV),
-                rangeOutput);
-
-    // Determines how many times to erode then dilate
-    int noise_filter_count = 5;
-    for (int i = 0; i < noise_filter_count; i++) {
-        cv::Size size = cv::Size(2, 2);
-        // Morphological Opening (removes small objects from foreground)
-        cv::erode(rangeOutput,
-                  rangeOutput,
-                  getStructuringElement(cv::MORPH_ELLIPSE, size));
-        cv::dilate(rangeOutput,
-                   rangeOutput,
-                   getStructuringElement(cv::MORPH_ELLIPSE, size));
-
-        cv::Size size2 = cv::Size(10, 10);
-        // Morphological Closing (fill small holes in the foreground)
-        cv::dilate(rangeOutput,
-                   rangeOutput,
-                   getStructuringElement(cv::MORPH_ELLIPSE, size2));
-        cv::erode(rangeOutput,
-                  rangeOutput,
-                  getStructuringElement(cv::MORPH_ELLIPSE, size2));
+    int halo       = getNoiseHalo();
+    int numStripes = getNumStripes(input.rows, halo);
+    if (numStripes <= 1) {
+        threshold(input, rangeOutput);
+        removeNoise(rangeOutput);
+        rangeOutput.copyTo(output);
+        return;
+    }
+
+    if (_useLUT && input.type() == CV_8UC3) updateLUT();
+
+    // Hold on to the input in case output is the same Mat
+    cv::Mat source = input;
+    output.create(source.size(), CV_8UC1);
+    _stripes.resize(numStripes);
+    cv::parallel_for_(cv::Range(0, numStripes),
+                      StripeFilter(*this, source, output, halo, true),
+                      numStripes);
+}
+
+void HSVFilter::threshold(const cv::Mat& input, cv::Mat& output) {
+    if (_useLUT && input.type() == CV_8UC3) {
+        // The thresholds may have been changed by the calibration trackbars
+        updateLUT();
+        output.create(input.size(), CV_8UC1);
+        cv::parallel_for_(cv::Range(0, input.rows),
+                          LUTClassifier(input, output, _lut));
+    } else {
+        cv::cvtColor(input, hsvOutput, CV_BGR2HSV, 0);
+        cv::inRange(hsvOutput, getLowerBound(), getUpperBound(), output);
     }
-    rangeOutput.copyTo(output);
+}
+
+void HSVFilter::removeNoise(cv::Mat& image) {
+    if (_noiseFilter == COMPONENT_AREA) {
+        // Remove small objects from the foreground
+        cv::connectedComponentsWithStats(
+        image, _labels, _stats, _centroids, 8, CV_32S);
+        setComponents(image, 0, _minComponentArea - 1, false, 0);
+
+        // Fill small holes in the foreground, which are the small
+        // background components that don't reach the border
+        cv::connectedComponentsWithStats(
+        image == 0, _labels, _stats, _centroids, 4, CV_32S);
+        setComponents(image, 0, _maxHoleArea, true, 255);
+        return;
+    }
+
+    int halo       = getNoiseHalo();
+    int numStripes = getNumStripes(image.rows, halo);
+    if (numStripes <= 1) {
+        morphology(image);
+        return;
+    }
+
+    // The stripes read rows either side of them, so can't work in place
+    _noiseOutput.create(image.size(), image.type());
+    _stripes.resize(numStripes);
+    cv::parallel_for_(cv::Range(0, numStripes),
+                      StripeFilter(*this, image, _noiseOutput, halo, false),
+                      numStripes);
+    _noiseOutput.copyTo(image);
+}
+
+void HSVFilter::morphology(cv::Mat& image) const {
+    switch (_noiseFilter) {
+        case ITERATIVE: {
+            for (int i = 0; i < ITERATIVE_PASSES; i++) {
+                // Morphological Opening (removes small objects from
+                // foreground)
+                cv::erode(image, image, _smallOpenKernel);
+                cv::dilate(image, image, _smallOpenKernel);
+
+                // Morphological Closing (fill small holes in the foreground)
+                cv::dilate(image, image, _smallCloseKernel);
+                cv::erode(image, image, _smallCloseKernel);
+            }
+            break;
+        }
+        case OPEN_CLOSE:
+            cv::morphologyEx(image, image, cv::MORPH_OPEN, _openKernel);
+            cv::morphologyEx(image, image, cv::MORPH_CLOSE, _closeKernel);
+            break;
+        case RECT_OPEN_CLOSE:
+            cv::morphologyEx(image, image, cv::MORPH_OPEN, _openKernel);
+            cv::morphologyEx(image, image, cv::MORPH_CLOSE, _rectCloseKernel);
+            break;
+        case COMPONENT_AREA: break;
+    }
+}
+
+int HSVFilter::getNoiseHalo(void) const {
+    // A kernel centred on a pixel reaches size / 2 rows away from it, and
+    // each erosion or dilation reaches further from what the last one read
+    switch (_noiseFilter) {
+        case ITERATIVE:
+            return ITERATIVE_PASSES * 2 *
+                   (_smallOpenKernel.rows / 2 + _smallCloseKernel.rows / 2);
+        case OPEN_CLOSE:
+            return 2 * (_openKernel.rows / 2 + _closeKernel.rows / 2);
+        case RECT_OPEN_CLOSE:
+            return 2 * (_openKernel.rows / 2 + _rectCloseKernel.rows / 2);
+        default: return -1;
+    }
+}
+
+int HSVFilter::getNumStripes(int rows, int halo) const {
+    if (halo < 0) return 1;
+    if (_numStripes > 0) return std::min(_numStripes, rows);
+
+    // Past this the halos cost more than the extra threads save
+    return std::max(1, std::min(cv::getNumThreads(), rows / (2 * halo + 1)));
+}
+
+void HSVFilter::setComponents(
+cv::Mat& image, int minArea, int maxArea, bool skipBorder, uchar value) {
+    // Which labels to set, label 0 is everything not in a component
+    std::vector<uchar> selected(_stats.rows, 0);
+    bool any = false;
+    for (int label = 1; label < _stats.rows; label++) {
+        const int* stats = _stats.ptr<int>(label);
+        int area         = stats[cv::CC_STAT_AREA];
+        bool on_border =
+        stats[cv::CC_STAT_LEFT] == 0 || stats[cv::CC_STAT_TOP] == 0 ||
+        stats[cv::CC_STAT_LEFT] + stats[cv::CC_STAT_WIDTH] == image.cols ||
+        stats[cv::CC_STAT_TOP] + stats[cv::CC_STAT_HEIGHT] == image.rows;
+
+        selected[label] =
+        area >= minArea && area <= maxArea && !(skipBorder && on_border);
+        any |= selected[label];
+    }
+    if (!any) return;
+
+    for (int j = 0; j < image.rows; j++) {
+        const int* labels = _labels.ptr<int>(j);
+        uchar* pixels     = image.ptr<uchar>(j);
+        for (int i = 0; i < image.cols; i++) {
+            if (selected[labels[i]]) pixels[i] = value;
+        }
+    }
+}
+
+void HSVFilter::updateLUT(void) {
+    std::array<int, 6> thresholds = getThresholds();
+    if (!_lut.empty() && thresholds == _lutThresholds) return;
+
+    _lut.resize((1 << 24) / 8);
+    cv::parallel_for_(cv::Range(0, 256),
+                      LUTBuilder(_lut, getLowerBound(), getUpperBound()));
+    _lutThresholds = thresholds;
+}
+
+std::array<int, 6> HSVFilter::getThresholds(void) const {
+    return {{_iLowH, _iHighH, _iLowS, _iHighS, _iLowV, _iHighV}};
+}
+
+cv::Scalar HSVFilter::getLowerBound(void) const {
+    return cv::Scalar(_iLowH, _iLowS, _iLowV);
+}
+
+cv::Scalar HSVFilter::getUpperBound(void) const {
+    return cv::Scalar(_iHighH, _iHighS, _iHighV);
 }
 
 void HSVFilter::printValues(void) {
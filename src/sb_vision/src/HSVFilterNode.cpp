@@ -11,17 +11,39 @@ using namespace cv;
 using namespace cv_bridge;
 
 HSVFilterNode::HSVFilterNode(int argc, char** argv, std::string node_name) {
-    displayWindowName  = "Snowbots - HSVFilterNode";
-    receivedFirstImage = false;
-
     // ROS
     ros::init(argc, argv, node_name);
     ros::NodeHandle nh;
     ros::NodeHandle private_nh("~");
 
-    // Set topics
-    std::string image_topic  = "/robot/vision/raw_image";
-    std::string output_topic = "/vision/hsv_filtered_image";
+    // The filter works on a horizontal stripe of the image per OpenCV thread.
+    // The thread count is global to the process, so a nodelet leaves it to
+    // whoever owns the manager.
+    int num_threads;
+    SB_getParam(private_nh, "num_threads", num_threads, 0);
+    if (num_threads > 0) cv::setNumThreads(num_threads);
+
+    setUpNode(nh, private_nh);
+}
+
+HSVFilterNode::HSVFilterNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh) {
+    setUpNode(nh, private_nh);
+}
+
+void HSVFilterNode::setUpNode(ros::NodeHandle& nh,
+                              ros::NodeHandle& private_nh) {
+    displayWindowName  = "Snowbots - HSVFilterNode";
+    receivedFirstImage = false;
+    ipmFilter          = nullptr;
+    hsvIpmFilter       = nullptr;
+    this->private_nh   = private_nh;
+
+    SB_getParam(private_nh, "fuse_ipm", fuse_ipm, false);
+
+    // Set topics, a fused filter replaces the IPM filter node's output
+    std::string image_topic = "/robot/vision/raw_image";
+    std::string output_topic =
+    fuse_ipm ? "/vision/ipm_filtered_image" : "/vision/hsv_filtered_image";
 
     // Setup image transport
     image_transport::ImageTransport it(nh);
@@ -44,45 +66,132 @@ HSVFilterNode::HSVFilterNode(int argc, char** argv, std::string node_name) {
     SB_getParam(
     private_nh, "show_calibration_window", isCalibratingManually, false);
 
+    if (fuse_ipm) {
+        // Same parameters as the IPM filter node
+        SB_getParam(private_nh, "ipm_base_width", ipm_base_width, (float) 1);
+        SB_getParam(private_nh, "ipm_top_width", ipm_top_width, (float) 0.5);
+        SB_getParam(
+        private_nh, "ipm_base_displacement", ipm_base_displacement, (float) 0);
+        SB_getParam(
+        private_nh, "ipm_top_displacement", ipm_top_displacement, (float) 0.25);
+
+        std::string default_cache_dir;
+        if (getenv("ROS_HOME")) {
+            default_cache_dir = getenv("ROS_HOME");
+        } else if (getenv("HOME")) {
+            default_cache_dir = std::string(getenv("HOME")) + "/.ros";
+        }
+        SB_getParam(
+        private_nh, "ipm_cache_dir", ipm_cache_dir, default_cache_dir);
+    }
+
     setUpFilter();
+
+    // Classify pixels with a lookup table of every colour, rebuilt whenever
+    // the thresholds are changed
+    bool use_colour_lut;
+    SB_getParam(private_nh, "use_colour_lut", use_colour_lut, true);
+    filter.setUseLUT(use_colour_lut);
+
+    // How the thresholded image is cleaned up. The cheaper filters publish a
+    // slightly different mask, so they have to be asked for.
+    std::string noise_filter_name;
+    SB_getParam(
+    private_nh, "noise_filter", noise_filter_name, std::string("iterative"));
+    int min_component_area, max_hole_area;
+    SB_getParam(private_nh, "min_component_area", min_component_area, 20);
+    SB_getParam(private_nh, "max_hole_area", max_hole_area, 80);
+    HSVFilter::NoiseFilter noise_filter;
+    if (!HSVFilter::parseNoiseFilter(noise_filter_name, noise_filter)) {
+        ROS_WARN("Unknown noise_filter %s, using iterative",
+                 noise_filter_name.c_str());
+        noise_filter = HSVFilter::ITERATIVE;
+    }
+    filter.setNoiseFilter(noise_filter, min_component_area, max_hole_area);
+    noiseFilter.setNoiseFilter(noise_filter, min_component_area, max_hole_area);
+
+    // Threshold, remove noise from and publish frames on a thread each, so
+    // the next frame can be thresholded while the last one is cleaned up
+    SB_getParam(private_nh, "pipelined", pipelined, false);
+    if (pipelined) {
+        int queue_size;
+        double stats_period;
+        SB_getParam(private_nh, "pipeline_queue_size", queue_size, 1);
+        SB_getParam(private_nh, "pipeline_stats_period", stats_period, 5.0);
+        stats_interval = ros::WallDuration(stats_period);
+        setUpPipeline(std::max(queue_size, 1));
+    }
 }
 
 void HSVFilterNode::rawImageCallBack(
 const sensor_msgs::Image::ConstPtr& image) {
     if (!receivedFirstImage) {
         ROS_INFO("First image received!");
-        ros::NodeHandle private_nh("~");
         SB_getParam(private_nh, "image_width", image_width, (int) image->width);
         SB_getParam(
         private_nh, "image_height", image_height, (int) image->height);
         receivedFirstImage = true;
+
+        if (fuse_ipm) setUpIPM();
+    }
+
+    if (pipeline) {
+        // Frames the stages can't keep up with are dropped, oldest first
+        PipelineFrame frame;
+        frame.input = toCvShare(image, image->encoding);
+        pipeline->push(frame);
+
+        if (ros::WallTime::now() - last_stats > stats_interval) {
+            logPipelineStats();
+        }
+        return;
     }
 
     imageInput = rosToMat(image);
 
-    // Filter out non-green colors
-    Mat filteredImage;
-    filter.filterImage(imageInput, filteredImage);
+    // Filter out non-green colors, straight into the message to publish
+    cv::Size output_size =
+    fuse_ipm ? ipmFilter->getIPM().getDstSize() : imageInput.size();
+    Mat filteredImage = output_buffer.next(image->header, output_size, "mono8");
+    if (fuse_ipm) {
+        if (!hsvIpmFilter->filterImage(imageInput,
+                                       filteredImage,
+                                       filter.getLowerBound(),
+                                       filter.getUpperBound())) {
+            ROS_WARN_THROTTLE(5,
+                              "Expected %dx%d bgr8 images, got %dx%d %s",
+                              image_width,
+                              image_height,
+                              image->width,
+                              image->height,
+                              image->encoding.c_str());
+            return;
+        }
+        filter.removeNoise(filteredImage);
+    } else {
+        filter.filterImage(imageInput, filteredImage);
+    }
     filterOutput = filteredImage;
 
     // If enough time has passed update filter and show image
     if ((ros::Time::now() - last_published) > publish_interval) {
         last_published = ros::Time::now();
         if (showWindow) { showRawAndFilteredImageWindow(); }
-        updateFilter();
+        // Keys only reach highgui's windows, so without any there's nothing
+        // to wait for
+        if (showWindow || isCalibratingManually) updateFilter();
     }
 
     // Outputs the image
-    sensor_msgs::ImagePtr output_message =
-    cv_bridge::CvImage(std_msgs::Header(), "mono8", filteredImage).toImageMsg();
-    // Publish recommended Twist message
-    filter_pub.publish(output_message);
+    filter_pub.publish(output_buffer.message());
 }
 
 Mat HSVFilterNode::rosToMat(const sensor_msgs::Image::ConstPtr& image) {
-    CvImagePtr imagePtr;
-    imagePtr = toCvCopy(image, image->encoding);
-    return imagePtr->image;
+    // The image is only read, so share the message's data rather than
+    // copying it. Holding on to the pointer keeps the message alive for as
+    // long as imageInput refers to it.
+    inputImagePtr = toCvShare(image, image->encoding);
+    return inputImagePtr->image;
 }
 
 void HSVFilterNode::setUpFilter() {
@@ -123,6 +232,105 @@ void HSVFilterNode::setUpFilter() {
     ROS_INFO("Waiting for first image");
 }
 
+void HSVFilterNode::setUpIPM() {
+    ros::WallTime start = ros::WallTime::now();
+    ipmFilter           = new IPMFilter(ipm_base_width,
+                              ipm_top_width,
+                              ipm_base_displacement,
+                              ipm_top_displacement,
+                              image_height,
+                              image_width,
+                              ipm_cache_dir);
+    hsvIpmFilter = new HSVIPMFilter(ipmFilter->getIPM());
+    ROS_INFO("Fused IPM ready in %.1f ms, thresholding %d of %d pixels",
+             (ros::WallTime::now() - start).toSec() * 1000,
+             hsvIpmFilter->getNumVisiblePixels(),
+             image_width * image_height);
+}
+
+void HSVFilterNode::setUpPipeline(int queue_size) {
+    // The windows aren't thread safe, and calibrating would change the
+    // thresholds while they are being used
+    if (showWindow || isCalibratingManually) {
+        ROS_WARN("Image and calibration windows are disabled when pipelined");
+        showWindow            = false;
+        isCalibratingManually = false;
+    }
+
+    // Keep a message for every frame that can be in the pipeline at once
+    const int num_stages = 3;
+    output_buffer = ImageMessageBuffer(num_stages * (queue_size + 1) + 1);
+
+    pipeline.reset(new VisionPipeline<PipelineFrame>(queue_size));
+    pipeline->addStage(
+    fuse_ipm ? "threshold_ipm" : "threshold",
+    [this](PipelineFrame& frame) { return thresholdStage(frame); });
+    pipeline->addStage(
+    "noise", [this](PipelineFrame& frame) { return noiseStage(frame); });
+    pipeline->addStage(
+    "publish", [this](PipelineFrame& frame) { return publishStage(frame); });
+    pipeline->start();
+
+    last_stats = ros::WallTime::now();
+    ROS_INFO(
+    "Filtering in a pipeline of %d stages, with up to %d frames "
+    "queued for each",
+    num_stages,
+    queue_size);
+}
+
+bool HSVFilterNode::thresholdStage(PipelineFrame& frame) {
+    const cv::Mat& input = frame.input->image;
+    cv::Size output_size =
+    fuse_ipm ? ipmFilter->getIPM().getDstSize() : input.size();
+    frame.mask = output_buffer.next(frame.input->header, output_size, "mono8");
+    frame.output = output_buffer.message();
+
+    if (!fuse_ipm) {
+        filter.threshold(input, frame.mask);
+        return true;
+    }
+
+    if (!hsvIpmFilter->filterImage(
+        input, frame.mask, filter.getLowerBound(), filter.getUpperBound())) {
+        ROS_WARN_THROTTLE(5,
+                          "Expected %dx%d bgr8 images, got %dx%d %s",
+                          image_width,
+                          image_height,
+                          input.cols,
+                          input.rows,
+                          frame.input->encoding.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool HSVFilterNode::noiseStage(PipelineFrame& frame) {
+    noiseFilter.removeNoise(frame.mask);
+    return true;
+}
+
+bool HSVFilterNode::publishStage(PipelineFrame& frame) {
+    filter_pub.publish(frame.output);
+    return true;
+}
+
+void HSVFilterNode::logPipelineStats() {
+    last_stats = ros::WallTime::now();
+    for (const auto& stats : pipeline->getStats()) {
+        ROS_INFO(
+        "%s: %llu frames, %llu dropped, %.0f%% busy, %.1f ms waiting, "
+        "%.1f ms processing, %.1f ms since received",
+        stats.name.c_str(),
+        (unsigned long long) stats.processed,
+        (unsigned long long) stats.dropped,
+        100 * stats.occupancy,
+        stats.wait_ms,
+        stats.process_ms,
+        stats.latency_ms);
+    }
+}
+
 void HSVFilterNode::updateFilter() {
     // Color filter calibration
     if (isCalibratingManually) filter.manualCalibration();
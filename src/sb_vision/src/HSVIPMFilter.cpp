@@ -0,0 +1,115 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Thresholds an image in the HSV colourspace and applies inverse
+ *              perspective mapping to it in a single pass, only looking at
+ *              the pixels the IPM image is made from.
+ */
+
+#include <HSVIPMFilter.h>
+
+using namespace cv;
+
+namespace {
+const int HSV_SHIFT = 12;
+
+// The fixed point reciprocals cv::cvtColor uses for 8 bit BGR to HSV
+struct HSVDivTables {
+    int sdiv[256];
+    int hdiv[256];
+
+    HSVDivTables() {
+        sdiv[0] = hdiv[0] = 0;
+        for (int i = 1; i < 256; i++) {
+            sdiv[i] = saturate_cast<int>((255 << HSV_SHIFT) / (1. * i));
+            hdiv[i] = saturate_cast<int>((180 << HSV_SHIFT) / (6. * i));
+        }
+    }
+};
+
+const HSVDivTables& divTables() {
+    static const HSVDivTables tables;
+    return tables;
+}
+
+// Thresholds a band of rows of the IPM image
+class HSVIPMBody : public ParallelLoopBody {
+  public:
+    HSVIPMBody(const Mat& _input,
+               Mat& _output,
+               const Mat& _sources,
+               const Scalar& _lower,
+               const Scalar& _upper)
+      : input(_input), output(_output), sources(_sources), tables(divTables()) {
+        for (int c = 0; c < 3; c++) {
+            lower[c] = cvCeil(_lower[c]);
+            upper[c] = cvFloor(_upper[c]);
+        }
+    }
+
+    void operator()(const Range& rows) const override {
+        const uchar* pixels = input.data;
+        for (int j = rows.start; j < rows.end; j++) {
+            const int* source = sources.ptr<int>(j);
+            uchar* out        = output.ptr<uchar>(j);
+            for (int i = 0; i < output.cols; i++) {
+                if (source[i] < 0) {
+                    out[i] = 0;
+                    continue;
+                }
+
+                // Same as cv::cvtColor(CV_BGR2HSV) for one pixel
+                const uchar* bgr = pixels + 3 * source[i];
+                int b = bgr[0], g = bgr[1], r = bgr[2];
+                int v    = std::max(b, std::max(g, r));
+                int vmin = std::min(b, std::min(g, r));
+                int diff = v - vmin;
+                int vr   = v == r ? -1 : 0;
+                int vg   = v == g ? -1 : 0;
+
+                int s =
+                (diff * tables.sdiv[v] + (1 << (HSV_SHIFT - 1))) >> HSV_SHIFT;
+                int h = (vr & (g - b)) + (~vr & ((vg & (b - r + 2 * diff)) +
+                                                 ((~vg) & (r - g + 4 * diff))));
+                h =
+                (h * tables.hdiv[diff] + (1 << (HSV_SHIFT - 1))) >> HSV_SHIFT;
+                h += h < 0 ? 180 : 0;
+
+                bool in_range = h >= lower[0] && h <= upper[0] &&
+                                s >= lower[1] && s <= upper[1] &&
+                                v >= lower[2] && v <= upper[2];
+                out[i] = in_range ? 255 : 0;
+            }
+        }
+    }
+
+  private:
+    const Mat& input;
+    Mat& output;
+    const Mat& sources;
+    const HSVDivTables& tables;
+    int lower[3], upper[3];
+};
+} // namespace
+
+HSVIPMFilter::HSVIPMFilter(const IPM& ipm) : source_size(ipm.getOrigSize()) {
+    ipm.getSourcePixels(sources);
+    num_visible_pixels = countNonZero(sources >= 0);
+}
+
+bool HSVIPMFilter::filterImage(const cv::Mat& input,
+                               cv::Mat& output,
+                               const cv::Scalar& lower,
+                               const cv::Scalar& upper) const {
+    if (input.type() != CV_8UC3 || input.size() != source_size) {
+        return false;
+    }
+
+    // The source indices assume rows follow each other directly
+    Mat continuous_input = input.isContinuous() ? input : input.clone();
+
+    output.create(sources.size(), CV_8UC1);
+    parallel_for_(Range(0, output.rows),
+                  HSVIPMBody(continuous_input, output, sources, lower, upper));
+    return true;
+}
@@ -9,14 +9,115 @@
 
 #include <IPM.h>
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
 using namespace cv;
 using namespace std;
 
+namespace {
+// Identifies a remap table cache file, and what it was built for
+struct MapCacheHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t origWidth, origHeight;
+    int32_t dstWidth, dstHeight;
+    float origPoints[8];
+    float dstPoints[8];
+};
+
+const char MAP_CACHE_MAGIC[8]    = "SBIPM";
+const uint32_t MAP_CACHE_VERSION = 1;
+
+MapCacheHeader makeCacheHeader(const Size& _origSize,
+                               const Size& _dstSize,
+                               const vector<Point2f>& _origPoints,
+                               const vector<Point2f>& _dstPoints) {
+    MapCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAP_CACHE_MAGIC, sizeof(header.magic));
+    header.version    = MAP_CACHE_VERSION;
+    header.origWidth  = _origSize.width;
+    header.origHeight = _origSize.height;
+    header.dstWidth   = _dstSize.width;
+    header.dstHeight  = _dstSize.height;
+    for (size_t i = 0; i < 4; i++) {
+        header.origPoints[2 * i]     = _origPoints[i].x;
+        header.origPoints[2 * i + 1] = _origPoints[i].y;
+        header.dstPoints[2 * i]      = _dstPoints[i].x;
+        header.dstPoints[2 * i + 1]  = _dstPoints[i].y;
+    }
+    return header;
+}
+
+bool readMat(ifstream& _in, Mat& _mat, const Size& _size, int _type) {
+    _mat.create(_size, _type);
+    size_t bytes = _mat.total() * _mat.elemSize();
+    _in.read(reinterpret_cast<char*>(_mat.data), bytes);
+    return static_cast<size_t>(_in.gcount()) == bytes;
+}
+
+void writeMat(ofstream& _out, const Mat& _mat) {
+    _out.write(reinterpret_cast<const char*>(_mat.data),
+               _mat.total() * _mat.elemSize());
+}
+
+// Fills the fixed point remap tables for a band of rows, by mapping each
+// pixel through a homography. Each band is converted as soon as it is
+// built, so the float maps never exist for the whole image.
+class MapBuilder : public ParallelLoopBody {
+  public:
+    MapBuilder(const Mat& _H, Mat& _map1, Mat& _map2)
+      : m_map1(_map1), m_map2(_map2) {
+        for (int i = 0; i < 9; i++) { m_h[i] = _H.at<double>(i / 3, i % 3); }
+    }
+
+    void operator()(const Range& _rows) const override {
+        Mat mapX(_rows.size(), m_map1.cols, CV_32F);
+        Mat mapY(_rows.size(), m_map1.cols, CV_32F);
+        for (int j = _rows.start; j < _rows.end; ++j) {
+            float* ptRowX = mapX.ptr<float>(j - _rows.start);
+            float* ptRowY = mapY.ptr<float>(j - _rows.start);
+
+            // Same as applyHomography, with the terms for the row hoisted
+            const double u0 = m_h[1] * j + m_h[2];
+            const double v0 = m_h[4] * j + m_h[5];
+            const double s0 = m_h[7] * j + m_h[8];
+            for (int i = 0; i < m_map1.cols; ++i) {
+                const double s = m_h[6] * i + s0;
+                if (s != 0) {
+                    ptRowX[i] = static_cast<float>((m_h[0] * i + u0) / s);
+                    ptRowY[i] = static_cast<float>((m_h[3] * i + v0) / s);
+                } else {
+                    ptRowX[i] = -1;
+                    ptRowY[i] = -1;
+                }
+            }
+        }
+
+        // Headers into the rows of the full tables, which are already
+        // allocated, so convertMaps writes straight into them
+        Mat map1 = m_map1.rowRange(_rows);
+        Mat map2 = m_map2.rowRange(_rows);
+        convertMaps(mapX, mapY, map1, map2, CV_16SC2, false);
+    }
+
+  private:
+    double m_h[9];
+    Mat& m_map1;
+    Mat& m_map2;
+};
+} // namespace
+
 // Public
 IPM::IPM(const cv::Size& _origSize,
          const cv::Size& _dstSize,
          const std::vector<cv::Point2f>& _origPoints,
-         const std::vector<cv::Point2f>& _dstPoints)
+         const std::vector<cv::Point2f>& _dstPoints,
+         const std::string& _cacheDir)
   : m_origSize(_origSize),
     m_dstSize(_dstSize),
     m_origPoints(_origPoints),
@@ -26,7 +127,18 @@ IPM::IPM(const cv::Size& _origSize,
     m_H     = getPerspectiveTransform(m_origPoints, m_dstPoints);
     m_H_inv = m_H.inv();
 
-    createMaps();
+    if (_cacheDir.empty()) {
+        createMaps();
+        return;
+    }
+
+    std::string path = cachePath(_cacheDir);
+    if (!loadMaps(path)) {
+        createMaps();
+        if (!saveMaps(path)) {
+            cerr << "Could not cache IPM maps in " << path << endl;
+        }
+    }
 }
 
 IPM::IPM() {}
@@ -81,8 +193,8 @@ void IPM::applyHomography(const Mat& _inputImg, Mat& _dstImg, int _borderMode) {
     // Generate IPM image from src
     remap(_inputImg,
           _dstImg,
-          m_mapX,
-          m_mapY,
+          m_map1,
+          m_map2,
           INTER_LINEAR,
           _borderMode); //, BORDER_CONSTANT, Scalar(0,0,0,0));
 }
@@ -90,15 +202,34 @@ void IPM::applyHomography(const Mat& _inputImg, Mat& _dstImg, int _borderMode) {
 void IPM::applyHomographyInv(const Mat& _inputImg,
                              Mat& _dstImg,
                              int _borderMode) {
-    // Generate IPM image from src
+    // Generate src image from IPM
     remap(_inputImg,
           _dstImg,
-          m_mapX,
-          m_mapY,
+          m_invMap1,
+          m_invMap2,
           INTER_LINEAR,
           _borderMode); //, BORDER_CONSTANT, Scalar(0,0,0,0));
 }
 
+void IPM::getSourcePixels(Mat& _sources) const {
+    // The fixed point maps hold the integer part of each coordinate, and the
+    // fractional parts in 1/INTER_TAB_SIZE steps packed as y * size + x
+    const int half = INTER_TAB_SIZE / 2;
+    _sources.create(m_dstSize, CV_32SC1);
+    for (int j = 0; j < m_dstSize.height; ++j) {
+        const Vec2s* ptRow1  = m_map1.ptr<Vec2s>(j);
+        const ushort* ptRow2 = m_map2.ptr<ushort>(j);
+        int* ptRowSources    = _sources.ptr<int>(j);
+        for (int i = 0; i < m_dstSize.width; ++i) {
+            int x = ptRow1[i][0] + ((ptRow2[i] % INTER_TAB_SIZE) >= half);
+            int y = ptRow1[i][1] + ((ptRow2[i] / INTER_TAB_SIZE) >= half);
+            bool inside =
+            x >= 0 && y >= 0 && x < m_origSize.width && y < m_origSize.height;
+            ptRowSources[i] = inside ? y * m_origSize.width + x : -1;
+        }
+    }
+}
+
 Point2d IPM::applyHomography(const Point2d& _point) {
     return applyHomography(_point, m_H);
 }
@@ -153,31 +284,84 @@ Point3d IPM::applyHomography(const Point3d& _point, const cv::Mat& _H) {
 
 // Private
 void IPM::createMaps() {
-    // Create remap images
-    m_mapX.create(m_dstSize, CV_32F);
-    m_mapY.create(m_dstSize, CV_32F);
-    for (int j = 0; j < m_dstSize.height; ++j) {
-        float* ptRowX = m_mapX.ptr<float>(j);
-        float* ptRowY = m_mapY.ptr<float>(j);
-        for (int i = 0; i < m_dstSize.width; ++i) {
-            Point2f pt = applyHomography(
-            Point2f(static_cast<float>(i), static_cast<float>(j)), m_H_inv);
-            ptRowX[i] = pt.x;
-            ptRowY[i] = pt.y;
-        }
+    // Create remap images, each IPM pixel samples the original image at its
+    // inverse homography
+    m_map1.create(m_dstSize, CV_16SC2);
+    m_map2.create(m_dstSize, CV_16UC1);
+    parallel_for_(Range(0, m_dstSize.height),
+                  MapBuilder(m_H_inv, m_map1, m_map2));
+
+    m_invMap1.create(m_origSize, CV_16SC2);
+    m_invMap2.create(m_origSize, CV_16UC1);
+    parallel_for_(Range(0, m_origSize.height),
+                  MapBuilder(m_H, m_invMap1, m_invMap2));
+}
+
+std::string IPM::cachePath(const std::string& _cacheDir) const {
+    MapCacheHeader header =
+    makeCacheHeader(m_origSize, m_dstSize, m_origPoints, m_dstPoints);
+
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char* bytes =
+    reinterpret_cast<const unsigned char*>(&header);
+    for (size_t i = 0; i < sizeof(header); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
     }
 
-    m_invMapX.create(m_origSize, CV_32F);
-    m_invMapY.create(m_origSize, CV_32F);
-
-    for (int j = 0; j < m_origSize.height; ++j) {
-        float* ptRowX = m_invMapX.ptr<float>(j);
-        float* ptRowY = m_invMapY.ptr<float>(j);
-        for (int i = 0; i < m_origSize.width; ++i) {
-            Point2f pt = applyHomography(
-            Point2f(static_cast<float>(i), static_cast<float>(j)), m_H);
-            ptRowX[i] = pt.x;
-            ptRowY[i] = pt.y;
+    char name[32];
+    snprintf(
+    name, sizeof(name), "ipm_maps_%016llx.bin", (unsigned long long) hash);
+    return _cacheDir + "/" + name;
+}
+
+bool IPM::loadMaps(const std::string& _path) {
+    ifstream in(_path.c_str(), ios::binary);
+    if (!in) return false;
+
+    // The hash in the name could collide, so check what the maps are for
+    MapCacheHeader expected =
+    makeCacheHeader(m_origSize, m_dstSize, m_origPoints, m_dstPoints);
+    MapCacheHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (static_cast<size_t>(in.gcount()) != sizeof(header) ||
+        memcmp(&header, &expected, sizeof(header)) != 0) {
+        return false;
+    }
+
+    return readMat(in, m_map1, m_dstSize, CV_16SC2) &&
+           readMat(in, m_map2, m_dstSize, CV_16UC1) &&
+           readMat(in, m_invMap1, m_origSize, CV_16SC2) &&
+           readMat(in, m_invMap2, m_origSize, CV_16UC1) &&
+           in.peek() == ifstream::traits_type::eof();
+}
+
+bool IPM::saveMaps(const std::string& _path) const {
+    // Write to a temporary file first, so other nodes never load a
+    // partially written one
+    std::string tmp_path = _path + ".tmp" + to_string(getpid());
+    {
+        ofstream out(tmp_path.c_str(), ios::binary | ios::trunc);
+        if (!out) return false;
+
+        MapCacheHeader header =
+        makeCacheHeader(m_origSize, m_dstSize, m_origPoints, m_dstPoints);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeMat(out, m_map1);
+        writeMat(out, m_map2);
+        writeMat(out, m_invMap1);
+        writeMat(out, m_invMap2);
+
+        if (!out.good()) {
+            out.close();
+            remove(tmp_path.c_str());
+            return false;
         }
     }
-}
\ No newline at end of file
+
+    if (rename(tmp_path.c_str(), _path.c_str()) != 0) {
+        remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -14,13 +14,15 @@ IPMFilter::IPMFilter(float ipm_base_width,
                      float ipm_base_displacement,
                      float ipm_top_displacement,
                      float image_height,
-                     float image_width) {
+                     float image_width,
+                     const std::string& cache_dir) {
     createFilter(ipm_base_width,
                  ipm_top_width,
                  ipm_base_displacement,
                  ipm_top_displacement,
                  image_height,
-                 image_width);
+                 image_width,
+                 cache_dir);
 }
 
 void IPMFilter::createFilter(float ipm_base_width,
@@ -28,7 +30,8 @@ void IPMFilter::createFilter(float ipm_base_width,
                              float ipm_base_displacement,
                              float ipm_top_displacement,
                              float image_height,
-                             float image_width) {
+                             float image_width,
+                             const std::string& cache_dir) {
     x1 = image_width / 2 - ipm_base_width / 2 * image_width;
     y1 = (1 - ipm_base_displacement) * image_height;
     x2 = image_width / 2 + ipm_base_width / 2 * image_width;
@@ -53,15 +56,20 @@ void IPMFilter::createFilter(float ipm_base_width,
     ipm = IPM(Size(image_width, image_height),
               Size(image_width, image_height),
               orig_points,
-              dst_points);
+              dst_points,
+              cache_dir);
 }
 
 void IPMFilter::filterImage(const cv::Mat& input, cv::Mat& output) {
     // If input image is empty then quit
-    if (!input.empty()) {
-        Mat workingImage;
+    if (input.empty()) return;
+
+    // Applies the IPM to the image, remap can't work in place so the input
+    // is only copied if it is the output
+    if (input.data == output.data) {
         input.copyTo(workingImage);
-        // Applies the IPM to the image
         ipm.applyHomography(workingImage, output);
+    } else {
+        ipm.applyHomography(input, output);
     }
 }
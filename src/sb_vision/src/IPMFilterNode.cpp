@@ -11,17 +11,34 @@ using namespace cv;
 using namespace cv_bridge;
 
 IPMFilterNode::IPMFilterNode(int argc, char** argv, std::string node_name) {
+    // ROS
+    ros::init(argc, argv, node_name);
+    ros::NodeHandle nh;
+    ros::NodeHandle private_nh("~");
+
+    // cv::remap splits the image into rows across OpenCV's threads, 0 leaves
+    // it with one per core. Not set as a nodelet, where it would change the
+    // threads of every other nodelet in the manager too.
+    int num_threads;
+    SB_getParam(private_nh, "num_threads", num_threads, 0);
+    if (num_threads > 0) cv::setNumThreads(num_threads);
+
+    setUpNode(nh, private_nh);
+}
+
+IPMFilterNode::IPMFilterNode(ros::NodeHandle& nh, ros::NodeHandle& private_nh) {
+    setUpNode(nh, private_nh);
+}
+
+void IPMFilterNode::setUpNode(ros::NodeHandle& nh,
+                              ros::NodeHandle& private_nh) {
     receivedFirstImage = false;
+    ipmFilter          = nullptr;
 
     // Set topics
     std::string image_topic  = "/vision/hsv_filtered_image";
     std::string output_topic = "/vision/ipm_filtered_image";
 
-    // ROS
-    ros::init(argc, argv, node_name);
-    ros::NodeHandle nh;
-    ros::NodeHandle private_nh("~");
-
     // Setup image transport
     image_transport::ImageTransport it(nh);
 
@@ -39,6 +56,22 @@ IPMFilterNode::IPMFilterNode(int argc, char** argv, std::string node_name) {
     private_nh, "ipm_base_displacement", ipm_base_displacement, (float) 0);
     SB_getParam(
     private_nh, "ipm_top_displacement", ipm_top_displacement, (float) 0.25);
+
+    // Building the IPM maps takes a while, so they are cached in ROS_HOME
+    std::string default_cache_dir;
+    if (getenv("ROS_HOME")) {
+        default_cache_dir = getenv("ROS_HOME");
+    } else if (getenv("HOME")) {
+        default_cache_dir = std::string(getenv("HOME")) + "/.ros";
+    }
+    SB_getParam(private_nh, "ipm_cache_dir", ipm_cache_dir, default_cache_dir);
+
+    // If the image size is known up front, get the maps ready before the
+    // first image arrives
+    if (private_nh.getParam("image_width", image_width) &&
+        private_nh.getParam("image_height", image_height)) {
+        createIPMFilter();
+    }
 }
 
 IPMFilterNode::IPMFilterNode(){};
@@ -46,36 +79,39 @@ IPMFilterNode::IPMFilterNode(){};
 void IPMFilterNode::filteredImageCallBack(
 const sensor_msgs::ImageConstPtr& msg) {
     if (!receivedFirstImage) {
-        ros::NodeHandle private_nh("~");
         ROS_INFO("First image received! (IPM)");
         receivedFirstImage = true;
-        // Obtains parameters of image and IPM points from the param server
-        SB_getParam(private_nh, "image_width", image_width, (int) msg->width);
-        SB_getParam(
-        private_nh, "image_height", image_height, (int) msg->height);
-        ipmFilter = new IPMFilter(ipm_base_width,
-                                  ipm_top_width,
-                                  ipm_base_displacement,
-                                  ipm_top_displacement,
-                                  image_height,
-                                  image_width);
+        if (!ipmFilter) {
+            // Use the size of the images actually received
+            image_width  = msg->width;
+            image_height = msg->height;
+            createIPMFilter();
+        }
     }
 
-    Mat imageInput = rosToMat(msg);
-    Mat IPMFilteredImage;
+    // Shares the message's data, which stays alive as long as the pointer
+    CvImageConstPtr imagePtr = toCvShare(msg, msg->encoding);
 
-    // Filter the image
-    ipmFilter->filterImage(imageInput, IPMFilteredImage);
+    // Filter the image straight into the message to publish
+    Mat IPMFilteredImage = output_buffer.next(
+    msg->header, ipmFilter->getIPM().getDstSize(), msg->encoding);
+    ipmFilter->filterImage(imagePtr->image, IPMFilteredImage);
 
     // Outputs the image
-    sensor_msgs::ImagePtr output_message =
-    cv_bridge::CvImage(std_msgs::Header(), "mono8", IPMFilteredImage)
-    .toImageMsg();
-    ipm_filter_pub.publish(output_message);
+    ipm_filter_pub.publish(output_buffer.message());
 }
 
-Mat IPMFilterNode::rosToMat(const sensor_msgs::Image::ConstPtr& image) {
-    CvImagePtr imagePtr;
-    imagePtr = toCvCopy(image, image->encoding);
-    return imagePtr->image;
+void IPMFilterNode::createIPMFilter() {
+    ros::WallTime start = ros::WallTime::now();
+    ipmFilter           = new IPMFilter(ipm_base_width,
+                              ipm_top_width,
+                              ipm_base_displacement,
+                              ipm_top_displacement,
+                              image_height,
+                              image_width,
+                              ipm_cache_dir);
+    ROS_INFO("IPM filter for %dx%d images ready in %.1f ms",
+             image_width,
+             image_height,
+             (ros::WallTime::now() - start).toSec() * 1000);
 }
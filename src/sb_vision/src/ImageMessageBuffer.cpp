@@ -0,0 +1,50 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: An image message that is reused from frame to frame
+ */
+
+#include <ImageMessageBuffer.h>
+#include <boost/make_shared.hpp>
+#include <cv_bridge/cv_bridge.h>
+
+ImageMessageBuffer::ImageMessageBuffer(size_t max_messages)
+  : max_messages(max_messages > 0 ? max_messages : 1),
+    current(0),
+    oldest(0),
+    num_allocations(0) {}
+
+cv::Mat ImageMessageBuffer::next(const std_msgs::Header& header,
+                                 const cv::Size& size,
+                                 const std::string& encoding) {
+    // Look for a message only this buffer holds
+    size_t free = 0;
+    while (free < messages.size() && !messages[free].unique()) { free++; }
+
+    if (free < messages.size()) {
+        current = free;
+    } else if (messages.size() < max_messages) {
+        current = messages.size();
+        messages.push_back(boost::make_shared<sensor_msgs::Image>());
+        num_allocations++;
+    } else {
+        // Let whoever holds the oldest message keep it
+        current           = oldest;
+        oldest            = (oldest + 1) % max_messages;
+        messages[current] = boost::make_shared<sensor_msgs::Image>();
+        num_allocations++;
+    }
+    sensor_msgs::Image* msg = messages[current].get();
+
+    int type          = cv_bridge::getCvType(encoding);
+    msg->header       = header;
+    msg->height       = size.height;
+    msg->width        = size.width;
+    msg->encoding     = encoding;
+    msg->is_bigendian = 0;
+    msg->step         = size.width * CV_ELEM_SIZE(type);
+    // Doesn't reallocate unless the frame got bigger
+    msg->data.resize(msg->step * msg->height);
+
+    return cv::Mat(size, type, msg->data.data(), msg->step);
+}
@@ -0,0 +1,23 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which detects circles, like a lit
+ *              stoplight, in a filtered image.
+ */
+
+#include <circle_detection_nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_vision;
+
+CircleDetectionNodelet::CircleDetectionNodelet() {}
+
+void CircleDetectionNodelet::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    circle_detection.reset(
+    new CircleDetection(getNodeHandle(), getPrivateNodeHandle()));
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(CircleDetectionNodelet, nodelet::Nodelet)
@@ -0,0 +1,114 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Times HSVFilter's thresholding and each of its noise filters
+ *              on a set of images, and compares each noise filter's mask to
+ *              the iterative one. Doesn't need ROS to be running.
+ *
+ *              hsv_filter_benchmark image.jpg... [--repeat 20]
+ */
+
+#include <HSVFilter.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+// Objects as CircleDetection counts them, with a radius of at least 20
+static int countObjects(const cv::Mat& mask) {
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(
+    mask.clone(), contours, CV_RETR_TREE, CV_CHAIN_APPROX_NONE);
+
+    int count = 0;
+    for (const std::vector<cv::Point>& contour : contours) {
+        cv::Point2f centre;
+        float radius;
+        cv::minEnclosingCircle(contour, centre, radius);
+        if (radius >= 20) count++;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> image_paths;
+    int repeat = 20;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else {
+            image_paths.push_back(argv[i]);
+        }
+    }
+    if (image_paths.empty()) {
+        std::fprintf(stderr, "usage: %s image... [--repeat 20]\n", argv[0]);
+        return 1;
+    }
+
+    const char* names[] = {
+    "iterative", "open_close", "rect_open_close", "component_area"};
+
+    for (const std::string& path : image_paths) {
+        cv::Mat image = cv::imread(path);
+        if (image.empty()) {
+            std::fprintf(stderr, "could not read %s\n", path.c_str());
+            continue;
+        }
+        std::printf("%s (%dx%d)\n", path.c_str(), image.cols, image.rows);
+
+        HSVFilter filter;
+        cv::Mat thresholded;
+
+        // Thresholding, the lookup table is built on its first use
+        for (int use_lut = 0; use_lut < 2; use_lut++) {
+            filter.setUseLUT(use_lut);
+            filter.threshold(image, thresholded);
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < repeat; i++) {
+                filter.threshold(image, thresholded);
+            }
+            std::printf("  %-16s %8.3f ms\n",
+                        use_lut ? "threshold lut" : "threshold hsv",
+                        millisecondsSince(start) / repeat);
+        }
+
+        std::printf("  %-16s %11s %9s %9s %7s\n",
+                    "noise filter",
+                    "ms",
+                    "pixels",
+                    "changed",
+                    "objects");
+        cv::Mat iterative;
+        for (int mode = HSVFilter::ITERATIVE; mode <= HSVFilter::COMPONENT_AREA;
+             mode++) {
+            filter.setNoiseFilter(static_cast<HSVFilter::NoiseFilter>(mode));
+
+            cv::Mat mask;
+            double total = 0;
+            for (int i = 0; i < repeat; i++) {
+                mask                    = thresholded.clone();
+                Clock::time_point start = Clock::now();
+                filter.removeNoise(mask);
+                total += millisecondsSince(start);
+            }
+            if (mode == HSVFilter::ITERATIVE) iterative = mask;
+
+            std::printf("  %-16s %8.3f ms %9d %9d %7d\n",
+                        names[mode],
+                        total / repeat,
+                        cv::countNonZero(mask),
+                        cv::countNonZero(mask != iterative),
+                        countObjects(mask));
+        }
+    }
+}
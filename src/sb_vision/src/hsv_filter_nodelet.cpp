@@ -0,0 +1,23 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which filters an image in the HSV colourspace
+ *              to a binary image.
+ */
+
+#include <hsv_filter_nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_vision;
+
+HSVFilterNodelet::HSVFilterNodelet() {}
+
+void HSVFilterNodelet::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    hsv_filter.reset(
+    new HSVFilterNode(getNodeHandle(), getPrivateNodeHandle()));
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(HSVFilterNodelet, nodelet::Nodelet)
@@ -0,0 +1,23 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: A ros nodelet which applies inverse perspective mapping to
+ *              a filtered image.
+ */
+
+#include <ipm_filter_nodelet.h>
+#include <pluginlib/class_list_macros.h>
+
+using namespace sb_vision;
+
+IPMFilterNodelet::IPMFilterNodelet() {}
+
+void IPMFilterNodelet::onInit() {
+    NODELET_DEBUG("Initializing Nodelet...");
+    ipm_filter.reset(
+    new IPMFilterNode(getNodeHandle(), getPrivateNodeHandle()));
+    NODELET_DEBUG("Nodelet Initialized");
+}
+
+// Allows this node to be exported and registered as a nodelet
+PLUGINLIB_EXPORT_CLASS(IPMFilterNodelet, nodelet::Nodelet)
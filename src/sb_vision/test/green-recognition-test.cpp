@@ -43,6 +43,56 @@ TEST(filteredImage, oneCircle) {
     EXPECT_EQ(1, num_circles);
 }
 
+TEST(tracking, GreenLight) {
+    cv::Mat bgr_image = imread("images/GreenLight.jpg");
+    Mat filtered_image;
+    HSVFilter().filterImage(bgr_image, filtered_image);
+
+    CircleDetection circle_detection;
+    circle_detection.setTracking(true);
+    EXPECT_EQ(1, circle_detection.countCircles(filtered_image, false));
+
+    // Only the region around the light is searched once it's found
+    cv::Rect roi = circle_detection.getTrackedROI();
+    EXPECT_GT(roi.area(), 0);
+    EXPECT_LT(roi.area(), filtered_image.size().area() / 10);
+    EXPECT_EQ(1, circle_detection.countCircles(filtered_image, false));
+    EXPECT_EQ(roi, circle_detection.getTrackedROI());
+
+    cv::Mat red_image = imread("images/RedLight.jpg");
+    HSVFilter().filterImage(red_image, filtered_image);
+    EXPECT_EQ(0, circle_detection.countCircles(filtered_image, false));
+    EXPECT_EQ(0, circle_detection.getTrackedROI().area());
+}
+
+TEST(tracking, FollowsTheLight) {
+    cv::Mat image = cv::Mat::zeros(480, 640, CV_8UC1);
+    cv::circle(image, cv::Point(100, 100), 30, 255, CV_FILLED);
+
+    CircleDetection circle_detection;
+    circle_detection.setTracking(true);
+    EXPECT_EQ(1, circle_detection.countCircles(image, false));
+    EXPECT_TRUE(circle_detection.getTrackedROI().contains(cv::Point(100, 100)));
+
+    // Moving a little stays within the region searched
+    image.setTo(0);
+    cv::circle(image, cv::Point(120, 110), 30, 255, CV_FILLED);
+    EXPECT_EQ(1, circle_detection.countCircles(image, false));
+    EXPECT_TRUE(circle_detection.getTrackedROI().contains(cv::Point(120, 110)));
+
+    // Moving away is found again in the same image, even when the light is
+    // only just big enough to count
+    image.setTo(0);
+    cv::circle(image, cv::Point(500, 400), 21, 255, CV_FILLED);
+    EXPECT_EQ(1, circle_detection.countCircles(image, false));
+    EXPECT_TRUE(circle_detection.getTrackedROI().contains(cv::Point(500, 400)));
+
+    // Specks are never counted
+    image.setTo(0);
+    cv::circle(image, cv::Point(300, 200), 5, 255, CV_FILLED);
+    EXPECT_EQ(0, circle_detection.countCircles(image, false));
+}
+
 int main(int imageTests, char** argv) {
     testing::InitGoogleTest(&imageTests, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,203 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests for HSVFilter
+ */
+
+#include <HSVFilter.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <tuple>
+
+static void expectSameMask(const cv::Mat& expected, const cv::Mat& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.type(), actual.type());
+    EXPECT_EQ(0, cv::countNonZero(expected != actual));
+}
+
+class HSVFilterLUTTest : public testing::TestWithParam<std::string> {};
+
+TEST_P(HSVFilterLUTTest, LUTMatchesConvertingToHSV) {
+    cv::Mat image = cv::imread(GetParam());
+    ASSERT_FALSE(image.empty());
+
+    HSVFilter filter(30, 90, 100, 255, 100, 255);
+    cv::Mat expected, actual;
+    filter.filterImage(image, expected);
+
+    filter.setUseLUT(true);
+    filter.filterImage(image, actual);
+    expectSameMask(expected, actual);
+}
+
+INSTANTIATE_TEST_CASE_P(Images,
+                        HSVFilterLUTTest,
+                        testing::Values("images/GreenLight.jpg",
+                                        "images/RedLight.jpg",
+                                        "images/circles.jpg"));
+
+TEST(HSVFilterLUT, EveryColourMatchesConvertingToHSV) {
+    // Every BGR colour once, as a 4096 x 4096 image
+    cv::Mat image(4096, 4096, CV_8UC3);
+    for (int i = 0; i < 1 << 24; i++) {
+        image.at<cv::Vec3b>(i >> 12, i & 4095) =
+        cv::Vec3b(i >> 16, (i >> 8) & 255, i & 255);
+    }
+
+    HSVFilter filter(20, 170, 40, 200, 10, 240);
+    cv::Mat expected, actual;
+    filter.threshold(image, expected);
+
+    filter.setUseLUT(true);
+    filter.threshold(image, actual);
+    expectSameMask(expected, actual);
+    EXPECT_GT(cv::countNonZero(actual), 0);
+}
+
+// Radii of the circles enclosing the objects of a mask, as CircleDetection
+// would count them
+static std::vector<float> objectRadii(const cv::Mat& mask) {
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(
+    mask.clone(), contours, CV_RETR_TREE, CV_CHAIN_APPROX_NONE);
+
+    std::vector<float> radii;
+    for (const std::vector<cv::Point>& contour : contours) {
+        cv::Point2f centre;
+        float radius;
+        cv::minEnclosingCircle(contour, centre, radius);
+        if (radius >= 20) radii.push_back(radius);
+    }
+    std::sort(radii.begin(), radii.end());
+    return radii;
+}
+
+class HSVFilterNoiseTest : public testing::TestWithParam<
+                           std::tuple<std::string, HSVFilter::NoiseFilter>> {};
+
+TEST_P(HSVFilterNoiseTest, FindsTheSameObjectsAsIterative) {
+    cv::Mat image = cv::imread(std::get<0>(GetParam()));
+    ASSERT_FALSE(image.empty());
+
+    HSVFilter filter;
+    cv::Mat thresholded;
+    filter.threshold(image, thresholded);
+
+    cv::Mat expected = thresholded.clone();
+    filter.setNoiseFilter(HSVFilter::ITERATIVE);
+    filter.removeNoise(expected);
+
+    cv::Mat actual = thresholded.clone();
+    filter.setNoiseFilter(std::get<1>(GetParam()));
+    filter.removeNoise(actual);
+
+    // ITERATIVE moves the mask by a few pixels, so compare the objects
+    // rather than the pixels
+    std::vector<float> expected_radii = objectRadii(expected);
+    std::vector<float> actual_radii   = objectRadii(actual);
+    ASSERT_EQ(expected_radii.size(), actual_radii.size());
+    for (size_t i = 0; i < expected_radii.size(); i++) {
+        EXPECT_NEAR(
+        expected_radii[i], actual_radii[i], 0.1 * expected_radii[i]);
+    }
+    EXPECT_NEAR(cv::countNonZero(expected),
+                cv::countNonZero(actual),
+                0.1 * cv::countNonZero(expected) + 50);
+}
+
+INSTANTIATE_TEST_CASE_P(
+Images,
+HSVFilterNoiseTest,
+testing::Combine(testing::Values("images/GreenLight.jpg",
+                                 "images/RedLight.jpg",
+                                 "images/circles.jpg",
+                                 "images/moreCircles.jpg"),
+                 testing::Values(HSVFilter::OPEN_CLOSE,
+                                 HSVFilter::RECT_OPEN_CLOSE,
+                                 HSVFilter::COMPONENT_AREA)));
+
+TEST(HSVFilterNoise, OpenCloseConvergesInOnePass) {
+    cv::Mat image = cv::imread("images/moreCircles.jpg");
+    ASSERT_FALSE(image.empty());
+
+    HSVFilter filter;
+    filter.setNoiseFilter(HSVFilter::OPEN_CLOSE);
+    cv::Mat once;
+    filter.threshold(image, once);
+    filter.removeNoise(once);
+
+    cv::Mat twice = once.clone();
+    filter.removeNoise(twice);
+    expectSameMask(once, twice);
+}
+
+TEST(HSVFilterNoise, ComponentAreaRemovesSpecksAndFillsHoles) {
+    cv::Mat mask = cv::Mat::zeros(100, 100, CV_8UC1);
+    // a speck, an object with a small hole, and one with a large hole
+    mask.at<uchar>(5, 5) = 255;
+    cv::rectangle(mask, cv::Rect(10, 10, 30, 30), 255, CV_FILLED);
+    cv::rectangle(mask, cv::Rect(20, 20, 5, 5), 0, CV_FILLED);
+    cv::rectangle(mask, cv::Rect(50, 50, 40, 40), 255, CV_FILLED);
+    cv::rectangle(mask, cv::Rect(55, 55, 20, 20), 0, CV_FILLED);
+
+    HSVFilter filter;
+    filter.setNoiseFilter(HSVFilter::COMPONENT_AREA, 4, 80);
+    filter.removeNoise(mask);
+
+    EXPECT_EQ(0, mask.at<uchar>(5, 5));
+    EXPECT_EQ(255, mask.at<uchar>(22, 22));
+    EXPECT_EQ(0, mask.at<uchar>(60, 60));
+    EXPECT_EQ(30 * 30 + 40 * 40 - 20 * 20, cv::countNonZero(mask));
+}
+
+class HSVFilterStripeTest
+: public testing::TestWithParam<HSVFilter::NoiseFilter> {};
+
+TEST_P(HSVFilterStripeTest, StripesMatchFilteringTheWholeImage) {
+    for (const char* path : {"images/GreenLight.jpg",
+                             "images/RedLight.jpg",
+                             "images/moreCircles.jpg"}) {
+        cv::Mat image = cv::imread(path);
+        ASSERT_FALSE(image.empty());
+
+        HSVFilter filter;
+        filter.setNoiseFilter(GetParam());
+        for (bool use_lut : {false, true}) {
+            filter.setUseLUT(use_lut);
+
+            cv::Mat expected, actual;
+            filter.setNumStripes(1);
+            filter.filterImage(image, expected);
+
+            // more stripes than threads, and ones thinner than their halos
+            for (int stripes : {3, 7, 40}) {
+                filter.setNumStripes(stripes);
+                filter.filterImage(image, actual);
+                expectSameMask(expected, actual);
+            }
+        }
+
+        cv::Mat thresholded, expected, actual;
+        filter.threshold(image, thresholded);
+        expected = thresholded.clone();
+        filter.setNumStripes(1);
+        filter.removeNoise(expected);
+
+        actual = thresholded.clone();
+        filter.setNumStripes(7);
+        filter.removeNoise(actual);
+        expectSameMask(expected, actual);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(NoiseFilters,
+                        HSVFilterStripeTest,
+                        testing::Values(HSVFilter::ITERATIVE,
+                                        HSVFilter::OPEN_CLOSE,
+                                        HSVFilter::RECT_OPEN_CLOSE,
+                                        HSVFilter::COMPONENT_AREA));
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests for the fused HSV and IPM filter
+ */
+
+#include <HSVIPMFilter.h>
+#include <gtest/gtest.h>
+#include <opencv2/imgproc/imgproc.hpp>
+
+using namespace cv;
+
+static IPM makeIPM(const Size& size) {
+    // The base is wider than the image, so the bottom corners of the IPM
+    // image come from outside it
+    std::vector<Point2f> orig_points = {
+    Point2f(-60, 150), Point2f(260, 150), Point2f(150, 40), Point2f(50, 40)};
+    std::vector<Point2f> dst_points = {
+    Point2f(0, 150), Point2f(200, 150), Point2f(200, 0), Point2f(0, 0)};
+    return IPM(size, size, orig_points, dst_points);
+}
+
+TEST(HSVIPMFilter, MatchesThresholdingTheWholeImage) {
+    Size size(200, 150);
+    IPM ipm = makeIPM(size);
+    HSVIPMFilter filter(ipm);
+
+    // Every kind of colour, so all branches of the HSV conversion are hit
+    Mat image(size, CV_8UC3);
+    randu(image, Scalar::all(0), Scalar::all(256));
+
+    Scalar lower(30, 50, 40), upper(100, 230, 250);
+    Mat fused;
+    ASSERT_TRUE(filter.filterImage(image, fused, lower, upper));
+    ASSERT_EQ(CV_8UC1, fused.type());
+    ASSERT_EQ(size, fused.size());
+
+    Mat hsv, thresholded, sources;
+    cvtColor(image, hsv, CV_BGR2HSV);
+    inRange(hsv, lower, upper, thresholded);
+    ipm.getSourcePixels(sources);
+
+    int visible = 0;
+    for (int j = 0; j < size.height; j++) {
+        for (int i = 0; i < size.width; i++) {
+            int source = sources.at<int>(j, i);
+            if (source < 0) {
+                ASSERT_EQ(0, fused.at<uchar>(j, i));
+                continue;
+            }
+            visible++;
+            ASSERT_EQ(
+            thresholded.at<uchar>(source / size.width, source % size.width),
+            fused.at<uchar>(j, i))
+            << "at " << i << ", " << j;
+        }
+    }
+    EXPECT_EQ(visible, filter.getNumVisiblePixels());
+    EXPECT_LT(visible, size.area());
+}
+
+TEST(HSVIPMFilter, RejectsImagesOfTheWrongSize) {
+    Size size(200, 150);
+    HSVIPMFilter filter(makeIPM(size));
+
+    Mat output;
+    EXPECT_FALSE(filter.filterImage(
+    Mat(Size(100, 75), CV_8UC3), output, Scalar(), Scalar()));
+    EXPECT_FALSE(
+    filter.filterImage(Mat(size, CV_8UC1), output, Scalar(), Scalar()));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests for ImageMessageBuffer
+ */
+
+#include <ImageMessageBuffer.h>
+#include <gtest/gtest.h>
+
+TEST(ImageMessageBuffer, WritesGoStraightIntoTheMessage) {
+    ImageMessageBuffer buffer;
+    std_msgs::Header header;
+    header.seq = 7;
+
+    cv::Mat image = buffer.next(header, cv::Size(4, 3), "mono8");
+    image.setTo(5);
+    image.at<uchar>(2, 3) = 9;
+
+    sensor_msgs::ImageConstPtr msg = buffer.message();
+    EXPECT_EQ(7, msg->header.seq);
+    EXPECT_EQ(4, msg->width);
+    EXPECT_EQ(3, msg->height);
+    EXPECT_EQ(4, msg->step);
+    EXPECT_EQ("mono8", msg->encoding);
+    ASSERT_EQ(12, msg->data.size());
+    EXPECT_EQ(5, msg->data[0]);
+    EXPECT_EQ(9, msg->data[11]);
+}
+
+TEST(ImageMessageBuffer, ReusesTheMessageOnceReleased) {
+    ImageMessageBuffer buffer;
+    buffer.next(std_msgs::Header(), cv::Size(640, 480), "bgr8");
+    const uint8_t* data = buffer.message()->data.data();
+    EXPECT_EQ(640 * 3, buffer.message()->step);
+
+    // Nothing else holds the message
+    cv::Mat image = buffer.next(std_msgs::Header(), cv::Size(640, 480), "bgr8");
+    EXPECT_EQ(data, image.data);
+    EXPECT_EQ(1, buffer.getNumAllocations());
+
+    // A subscriber in the same process still has it
+    sensor_msgs::ImageConstPtr held = buffer.message();
+    image = buffer.next(std_msgs::Header(), cv::Size(640, 480), "bgr8");
+    EXPECT_NE(held->data.data(), image.data);
+    EXPECT_EQ(2, buffer.getNumAllocations());
+}
+
+TEST(ImageMessageBuffer, KeepsAMessageForEachFrameInUse) {
+    ImageMessageBuffer buffer(2);
+    cv::Size size(8, 8);
+
+    buffer.next(std_msgs::Header(), size, "mono8");
+    sensor_msgs::ImageConstPtr first = buffer.message();
+    buffer.next(std_msgs::Header(), size, "mono8");
+    sensor_msgs::ImageConstPtr second = buffer.message();
+    EXPECT_NE(first, second);
+
+    // Whichever is released first is reused
+    const sensor_msgs::Image* released = first.get();
+    first.reset();
+    buffer.next(std_msgs::Header(), size, "mono8");
+    EXPECT_EQ(released, buffer.message().get());
+    EXPECT_EQ(2, buffer.getNumAllocations());
+
+    // Past the limit the oldest is given up on, and left to its holder
+    first = buffer.message();
+    buffer.next(std_msgs::Header(), size, "mono8");
+    EXPECT_NE(first, buffer.message());
+    EXPECT_NE(second, buffer.message());
+    EXPECT_EQ(3, buffer.getNumAllocations());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests for the IPM remap tables
+ */
+
+#include <IPM.h>
+#include <cstdlib>
+#include <dirent.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace cv;
+
+class IPMTest : public testing::Test {
+  protected:
+    IPMTest()
+      : size(64, 48),
+        orig_points(
+        {Point2f(8, 44), Point2f(56, 44), Point2f(44, 12), Point2f(20, 12)}),
+        dst_points(
+        {Point2f(0, 48), Point2f(64, 48), Point2f(64, 0), Point2f(0, 0)}),
+        xs(size, CV_32F),
+        ys(size, CV_32F) {
+        // Images where each pixel holds its own coordinates
+        for (int j = 0; j < size.height; j++) {
+            for (int i = 0; i < size.width; i++) {
+                xs.at<float>(j, i) = i;
+                ys.at<float>(j, i) = j;
+            }
+        }
+    }
+
+    // Names of the files in @dir
+    static std::vector<std::string> listFiles(const std::string& dir) {
+        std::vector<std::string> files;
+        DIR* d = opendir(dir.c_str());
+        if (!d) return files;
+        while (dirent* entry = readdir(d)) {
+            if (entry->d_name[0] != '.') files.push_back(entry->d_name);
+        }
+        closedir(d);
+        return files;
+    }
+
+    static bool inside(const Point2d& point, const Size& size) {
+        return point.x >= 0 && point.y >= 0 && point.x < size.width - 1 &&
+               point.y < size.height - 1;
+    }
+
+    Size size;
+    std::vector<Point2f> orig_points, dst_points;
+    Mat xs, ys;
+};
+
+TEST_F(IPMTest, RemapMatchesPointHomography) {
+    IPM ipm(size, size, orig_points, dst_points);
+
+    Mat ipm_xs, ipm_ys;
+    ipm.applyHomography(xs, ipm_xs);
+    ipm.applyHomography(ys, ipm_ys);
+
+    // Each IPM pixel samples the original image at its inverse homography,
+    // up to the 1/32 pixel resolution of the fixed point maps
+    int checked = 0;
+    for (int j = 0; j < size.height; j++) {
+        for (int i = 0; i < size.width; i++) {
+            Point2d source = ipm.applyHomographyInv(Point2d(i, j));
+            if (!inside(source, size)) continue;
+            EXPECT_NEAR(source.x, ipm_xs.at<float>(j, i), 0.05);
+            EXPECT_NEAR(source.y, ipm_ys.at<float>(j, i), 0.05);
+            checked++;
+        }
+    }
+    EXPECT_GT(checked, size.area() / 2);
+}
+
+TEST_F(IPMTest, InverseRemapUsesInverseTables) {
+    IPM ipm(size, size, orig_points, dst_points);
+
+    Mat orig_xs, orig_ys;
+    ipm.applyHomographyInv(xs, orig_xs);
+    ipm.applyHomographyInv(ys, orig_ys);
+
+    // Each original pixel samples the IPM image at its homography
+    int checked = 0;
+    for (int j = 0; j < size.height; j++) {
+        for (int i = 0; i < size.width; i++) {
+            Point2d target = ipm.applyHomography(Point2d(i, j));
+            if (!inside(target, size)) continue;
+            EXPECT_NEAR(target.x, orig_xs.at<float>(j, i), 0.05);
+            EXPECT_NEAR(target.y, orig_ys.at<float>(j, i), 0.05);
+            checked++;
+        }
+    }
+    EXPECT_GT(checked, 0);
+}
+
+TEST_F(IPMTest, CachedMapsAreReused) {
+    char dir_template[] = "/tmp/ipm-test-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir_template));
+    std::string dir = dir_template;
+
+    IPM built(size, size, orig_points, dst_points, dir);
+
+    // One file for these parameters
+    std::vector<std::string> files = listFiles(dir);
+    ASSERT_EQ(1, files.size());
+
+    IPM loaded(size, size, orig_points, dst_points, dir);
+    Mat expected, actual;
+    built.applyHomography(xs, expected);
+    loaded.applyHomography(xs, actual);
+    EXPECT_EQ(0, norm(expected, actual, NORM_INF));
+    built.applyHomographyInv(xs, expected);
+    loaded.applyHomographyInv(xs, actual);
+    EXPECT_EQ(0, norm(expected, actual, NORM_INF));
+
+    // A broken cache file is rebuilt
+    std::string path = dir + "/" + files[0];
+    ASSERT_EQ(0, truncate(path.c_str(), 100));
+    IPM rebuilt(size, size, orig_points, dst_points, dir);
+    rebuilt.applyHomography(xs, actual);
+    built.applyHomography(xs, expected);
+    EXPECT_EQ(0, norm(expected, actual, NORM_INF));
+
+    // Different parameters don't use the same file
+    orig_points[0].x += 1;
+    IPM other(size, size, orig_points, dst_points, dir);
+    other.applyHomography(xs, actual);
+    EXPECT_NE(0, norm(expected, actual, NORM_INF));
+
+    // The cache directory only holds files
+    for (const std::string& file : listFiles(dir)) {
+        EXPECT_EQ(0, unlink((dir + "/" + file).c_str()));
+    }
+    EXPECT_EQ(0, rmdir(dir.c_str()));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
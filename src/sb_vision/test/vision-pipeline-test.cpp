@@ -0,0 +1,241 @@
+/*
+ * Created By: agent
+ * Created On: October 18, 2026
+ * Description: Tests for FrameQueue and VisionPipeline
+ */
+
+#include <FrameQueue.h>
+#include <VisionPipeline.h>
+#include <atomic>
+#include <condition_variable>
+#include <gtest/gtest.h>
+
+typedef std::chrono::steady_clock Clock;
+
+// Waits for @done, giving up after ten seconds so a stuck pipeline fails
+// the test instead of hanging it
+template <typename Condition> static bool waitFor(Condition done) {
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(10);
+    while (!done()) {
+        if (Clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST(FrameQueue, DropsTheOldestFrameWhenFull) {
+    FrameQueue<int> queue(2);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_EQ(2, queue.size());
+    EXPECT_EQ(1, queue.getNumDropped());
+
+    int frame;
+    ASSERT_TRUE(queue.pop(frame));
+    EXPECT_EQ(2, frame);
+    ASSERT_TRUE(queue.pop(frame));
+    EXPECT_EQ(3, frame);
+    EXPECT_EQ(0, queue.size());
+}
+
+TEST(FrameQueue, CloseWakesTheConsumer) {
+    FrameQueue<int> queue(1);
+    std::atomic<bool> popped(true);
+    std::thread consumer([&] {
+        int frame;
+        popped = queue.pop(frame);
+    });
+
+    queue.close();
+    consumer.join();
+    EXPECT_FALSE(popped);
+    EXPECT_FALSE(queue.push(1));
+}
+
+TEST(VisionPipeline, StagesRunInOrder) {
+    VisionPipeline<std::vector<int>> pipeline(100);
+    std::mutex mutex;
+    std::vector<std::vector<int>> finished;
+    for (int s = 0; s < 3; s++) {
+        pipeline.addStage("stage", [s](std::vector<int>& frame) {
+            frame.push_back(s);
+            return true;
+        });
+    }
+    pipeline.addStage("output", [&](std::vector<int>& frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(frame);
+        return true;
+    });
+    pipeline.start();
+
+    for (int i = 0; i < 50; i++) { EXPECT_TRUE(pipeline.push({-i})); }
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return finished.size() == 50;
+    }));
+    pipeline.stop();
+
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(std::vector<int>({-i, 0, 1, 2}), finished[i]);
+    }
+}
+
+TEST(VisionPipeline, RejectedFramesGoNoFurther) {
+    VisionPipeline<int> pipeline(100);
+    std::atomic<int> num_finished(0);
+    pipeline.addStage("odd", [](int& frame) { return frame % 2 == 1; });
+    pipeline.addStage("output", [&](int&) {
+        num_finished++;
+        return true;
+    });
+    pipeline.start();
+
+    for (int i = 0; i < 10; i++) { pipeline.push(i); }
+    ASSERT_TRUE(waitFor([&] { return num_finished == 5; }));
+
+    std::vector<VisionPipeline<int>::StageStats> stats = pipeline.getStats();
+    ASSERT_EQ(2, stats.size());
+    EXPECT_EQ("odd", stats[0].name);
+    EXPECT_EQ(10, stats[0].processed);
+    EXPECT_EQ(5, stats[0].dropped);
+    EXPECT_EQ(5, stats[1].processed);
+    EXPECT_EQ(0, stats[1].dropped);
+}
+
+// Holds frames up in a stage until the test lets them through
+class Gate {
+  public:
+    // Called by the stage, waits until the frame is let through
+    void pass() {
+        std::unique_lock<std::mutex> lock(mutex);
+        arrived++;
+        changed.notify_all();
+        changed.wait(lock, [this] { return permits > 0; });
+        permits--;
+    }
+
+    // Lets @frames more frames through
+    void open(int frames) {
+        std::lock_guard<std::mutex> lock(mutex);
+        permits += frames;
+        changed.notify_all();
+    }
+
+    // How many frames have reached the gate
+    int getArrived() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return arrived;
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    int permits = 0;
+    int arrived = 0;
+};
+
+class GatedPipelineTest : public testing::Test {
+  protected:
+    GatedPipelineTest() : pipeline(1) {}
+
+    // Adds a stage that waits at @gate
+    void addGatedStage(const std::string& name, Gate& gate) {
+        pipeline.addStage(name, [&gate](int&) {
+            gate.pass();
+            return true;
+        });
+    }
+
+    // Adds the last stage, which records the frames that got through
+    void addOutputStage() {
+        pipeline.addStage("output", [this](int& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(frame);
+            return true;
+        });
+    }
+
+    std::vector<int> getFinished() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return finished;
+    }
+
+    // Lets everything through, so the stages can be stopped even if a test
+    // fails part way
+    void TearDown() override {
+        first.open(1000);
+        second.open(1000);
+        pipeline.stop();
+    }
+
+    Gate first, second;
+    std::mutex mutex;
+    std::vector<int> finished;
+    VisionPipeline<int> pipeline;
+};
+
+TEST_F(GatedPipelineTest, SlowStageDropsTheOldestFrames) {
+    addGatedStage("slow", first);
+    addOutputStage();
+    pipeline.start();
+
+    // Hold the first frame in the stage, then push more than can wait
+    EXPECT_TRUE(pipeline.push(0));
+    ASSERT_TRUE(waitFor([&] { return first.getArrived() == 1; }));
+    EXPECT_TRUE(pipeline.push(1));
+    for (int i = 2; i < 10; i++) { EXPECT_FALSE(pipeline.push(i)); }
+
+    std::vector<VisionPipeline<int>::StageStats> stats = pipeline.getStats();
+    ASSERT_EQ(2, stats.size());
+    EXPECT_EQ(0, stats[0].processed);
+    EXPECT_EQ(8, stats[0].dropped);
+    EXPECT_EQ(1, stats[0].queued);
+
+    // Only the frame being worked on and the newest one get through. They
+    // are let through one at a time, so the output stage's queue doesn't
+    // drop one of them too.
+    for (size_t i = 1; i <= 2; i++) {
+        first.open(1);
+        ASSERT_TRUE(waitFor([&] { return getFinished().size() == i; }));
+    }
+    EXPECT_EQ(std::vector<int>({0, 9}), getFinished());
+
+    // Once stopped, every stage has counted the frames it finished
+    pipeline.stop();
+    stats = pipeline.getStats();
+    EXPECT_EQ(2, stats[0].processed);
+    EXPECT_EQ(0, stats[0].dropped);
+    EXPECT_EQ(2, stats[1].processed);
+}
+
+TEST_F(GatedPipelineTest, StagesWorkOnDifferentFramesAtOnce) {
+    addGatedStage("first", first);
+    addGatedStage("second", second);
+    addOutputStage();
+    pipeline.start();
+
+    // Move the first frame on to the second stage, and hold it there
+    first.open(1);
+    pipeline.push(0);
+    ASSERT_TRUE(waitFor([&] { return second.getArrived() == 1; }));
+
+    // The first stage takes the next frame without waiting for the second
+    // one, so throughput is set by the slowest stage rather than their sum
+    pipeline.push(1);
+    ASSERT_TRUE(waitFor([&] { return first.getArrived() == 2; }));
+    EXPECT_TRUE(getFinished().empty());
+
+    first.open(1);
+    for (size_t i = 1; i <= 2; i++) {
+        second.open(1);
+        ASSERT_TRUE(waitFor([&] { return getFinished().size() == i; }));
+    }
+    EXPECT_EQ(std::vector<int>({0, 1}), getFinished());
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}